@@ -0,0 +1,100 @@
+#ifndef PARALLEL_SPLIT_HPP
+#define PARALLEL_SPLIT_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "split_text_simd.hpp"
+
+// split_text() of a large buffer on many threads - the buffer is cut into one chunk per thread and every chunk
+// is split on its own thread; the tokens are the same as those of split_text(), in the same order
+namespace parallel_split_details
+{
+    inline size_t default_no_of_threads() noexcept
+    {
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // boundary repair - a cut at position is moved forward to just past the next separator, so no token straddles
+    // two chunks; every chunk but the last ends with a separator, which split_text() does not follow by an empty token,
+    // so split_text() of the chunks, concatenated, is split_text() of the whole text
+    inline std::vector<size_t> chunk_boundaries(std::string_view text, std::string_view separators, size_t no_of_chunks)
+    {
+        std::vector<size_t> boundaries{0};
+        boundaries.reserve(no_of_chunks + 1);
+
+        for (size_t i = 1; i < no_of_chunks; ++i)
+        {
+            const size_t cut = std::max(boundaries.back(), i * text.size() / no_of_chunks);
+            const size_t separator = text.find_first_of(separators, cut);
+
+            boundaries.push_back(separator == std::string_view::npos ? text.size() : separator + 1);
+        }
+
+        boundaries.push_back(text.size());
+
+        return boundaries;
+    }
+
+    // calls f(i) for i in [0, n) - f(0) on the calling thread, the others on threads of their own
+    template <typename F>
+    void for_each_index_async(size_t n, F f)
+    {
+        std::vector<std::future<void>> tasks;
+        tasks.reserve(n - 1);
+
+        for (size_t i = 1; i < n; ++i)
+            tasks.push_back(std::async(std::launch::async, f, i));
+
+        f(0);
+
+        for (auto& t : tasks)
+            t.get();
+    }
+} // namespace parallel_split_details
+
+// tokens of every chunk in a segment of their own - concatenated in order they are split_text(text, separators)
+inline std::vector<std::vector<std::string_view>> parallel_split_text_segments(std::string_view text, std::string_view separators = " ,;",
+    size_t no_of_threads = parallel_split_details::default_no_of_threads())
+{
+    no_of_threads = std::clamp<size_t>(no_of_threads, 1, std::max<size_t>(text.size(), 1));
+
+    const auto boundaries = parallel_split_details::chunk_boundaries(text, separators, no_of_threads);
+
+    std::vector<std::vector<std::string_view>> segments(no_of_threads);
+
+    parallel_split_details::for_each_index_async(no_of_threads, [&](size_t chunk) {
+        segments[chunk] = split_text_simd(text.substr(boundaries[chunk], boundaries[chunk + 1] - boundaries[chunk]), separators);
+    });
+
+    return segments;
+}
+
+// the same tokens as split_text(text, separators) in a single container - the segments are copied
+// to their offsets in the result in parallel
+inline std::vector<std::string_view> parallel_split_text(std::string_view text, std::string_view separators = " ,;",
+    size_t no_of_threads = parallel_split_details::default_no_of_threads())
+{
+    auto segments = parallel_split_text_segments(text, separators, no_of_threads);
+
+    if (segments.size() == 1)
+        return std::move(segments.front());
+
+    std::vector<size_t> offsets(segments.size() + 1);
+    for (size_t i = 0; i < segments.size(); ++i)
+        offsets[i + 1] = offsets[i] + segments[i].size();
+
+    std::vector<std::string_view> tokens(offsets.back());
+
+    parallel_split_details::for_each_index_async(segments.size(), [&](size_t segment) {
+        std::copy(segments[segment].begin(), segments[segment].end(), tokens.begin() + offsets[segment]);
+    });
+
+    return tokens;
+}
+
+#endif // PARALLEL_SPLIT_HPP
@@ -0,0 +1,52 @@
+#ifndef SEPARATOR_SET_HPP
+#define SEPARATOR_SET_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// set of separator bytes as a 256-bit membership table - built at compile time from a literal:
+//   constexpr separator_set separators{" ,;"};
+// contains() is a shift and a mask whatever the size of the set
+class separator_set
+{
+    std::array<uint64_t, 4> bits_{};
+
+public:
+    constexpr separator_set() noexcept = default;
+
+    constexpr explicit separator_set(std::string_view separators) noexcept
+    {
+        for (char c : separators)
+        {
+            const auto byte = static_cast<unsigned char>(c);
+            bits_[byte >> 6] |= uint64_t{1} << (byte & 63);
+        }
+    }
+
+    constexpr bool contains(char c) const noexcept
+    {
+        const auto byte = static_cast<unsigned char>(c);
+        return (bits_[byte >> 6] >> (byte & 63)) & 1;
+    }
+
+    constexpr bool operator()(char c) const noexcept
+    {
+        return contains(c);
+    }
+
+    constexpr size_t size() const noexcept
+    {
+        size_t count = 0;
+        for (uint64_t word : bits_)
+        {
+            for (; word != 0; word &= word - 1)
+                ++count;
+        }
+
+        return count;
+    }
+};
+
+#endif // SEPARATOR_SET_HPP
@@ -0,0 +1,160 @@
+#ifndef SPLIT_TEXT_SIMD_HPP
+#define SPLIT_TEXT_SIMD_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define SPLIT_TEXT_HAS_AVX2_KERNEL 1
+#endif
+
+// split_text() with the separators found 64 bytes at a time - every block of text is classified into
+// a 64-bit separator mask, and token boundaries are pulled out of the mask with tzcnt (the structural
+// scan of simdjson); the tokens are the same as those of split_text(), empty ones included
+namespace split_simd
+{
+    // membership of every byte - nibble_rows[lo] has bit hi set when the byte (hi << 4 | lo) is a separator,
+    // so an ASCII byte is classified with two shuffles; separators >= 0x80 are found by the scalar kernel only
+    struct SeparatorTable
+    {
+        std::array<bool, 256> is_separator{};
+        std::array<uint8_t, 16> nibble_rows{};
+        bool ascii_only = true;
+
+        explicit SeparatorTable(std::string_view separators) noexcept
+        {
+            for (unsigned char c : separators)
+            {
+                is_separator[c] = true;
+
+                if (c < 0x80)
+                    nibble_rows[c & 0x0F] |= static_cast<uint8_t>(1u << (c >> 4));
+                else
+                    ascii_only = false;
+            }
+        }
+    };
+
+    // calls on_separator(position) for every separator in text, in order
+    template <typename OnSeparator>
+    void find_separators_scalar(std::string_view text, const SeparatorTable& table, size_t offset, OnSeparator& on_separator)
+    {
+        for (size_t i = offset; i < text.size(); ++i)
+        {
+            if (table.is_separator[static_cast<unsigned char>(text[i])])
+                on_separator(i);
+        }
+    }
+
+#ifdef SPLIT_TEXT_HAS_AVX2_KERNEL
+    __attribute__((target("avx2"))) inline uint32_t separator_mask_avx2(__m256i chunk, __m256i rows, __m256i bits) noexcept
+    {
+        const __m256i low_nibbles = _mm256_set1_epi8(0x0F);
+
+        __m256i row = _mm256_shuffle_epi8(rows, _mm256_and_si256(chunk, low_nibbles));
+        __m256i bit = _mm256_shuffle_epi8(bits, _mm256_and_si256(_mm256_srli_epi16(chunk, 4), low_nibbles));
+        __m256i not_separator = _mm256_cmpeq_epi8(_mm256_and_si256(row, bit), _mm256_setzero_si256());
+
+        return ~static_cast<uint32_t>(_mm256_movemask_epi8(not_separator));
+    }
+
+    // returns the offset the scalar kernel has to continue from
+    template <typename OnSeparator>
+    __attribute__((target("avx2,bmi,popcnt"))) size_t find_separators_avx2(std::string_view text, const SeparatorTable& table, OnSeparator& on_separator)
+    {
+        const __m128i rows_128 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(table.nibble_rows.data()));
+        const __m256i rows = _mm256_broadcastsi128_si256(rows_128); // shuffles look up within 128-bit lanes
+        const __m256i bits = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0,
+                                              1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0); // high nibbles >= 8 - never
+
+        const char* data = text.data();
+        size_t i = 0;
+
+        for (; i + 64 <= text.size(); i += 64)
+        {
+            __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 32));
+
+            uint64_t mask = separator_mask_avx2(low, rows, bits) | (static_cast<uint64_t>(separator_mask_avx2(high, rows, bits)) << 32);
+
+            on_separator.reserve(_mm_popcnt_u64(mask));
+
+            while (mask != 0)
+            {
+                on_separator(i + _tzcnt_u64(mask));
+                mask = _blsr_u64(mask); // clears the lowest set bit
+            }
+        }
+
+        return i;
+    }
+
+    inline bool has_avx2() noexcept
+    {
+        static const bool supported = [] {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi") && __builtin_cpu_supports("popcnt");
+        }();
+
+        return supported;
+    }
+#endif
+
+    class TokenCollector
+    {
+        std::string_view text_;
+        std::vector<std::string_view>& tokens_;
+        size_t token_start_ = 0;
+
+    public:
+        TokenCollector(std::string_view text, std::vector<std::string_view>& tokens) noexcept
+            : text_{text}, tokens_{tokens}
+        {
+        }
+
+        void reserve(size_t no_of_separators)
+        {
+            if (tokens_.capacity() < tokens_.size() + no_of_separators)
+                tokens_.reserve(2 * (tokens_.size() + no_of_separators));
+        }
+
+        void operator()(size_t separator_position)
+        {
+            tokens_.emplace_back(text_.data() + token_start_, separator_position - token_start_);
+            token_start_ = separator_position + 1;
+        }
+
+        // like split_text() - a separator at the very end is not followed by an empty token
+        void finish()
+        {
+            if (token_start_ < text_.size())
+                tokens_.emplace_back(text_.data() + token_start_, text_.size() - token_start_);
+        }
+    };
+} // namespace split_simd
+
+inline std::vector<std::string_view> split_text_simd(std::string_view text, std::string_view separators = " ,;")
+{
+    std::vector<std::string_view> tokens;
+
+    const split_simd::SeparatorTable table{separators};
+    split_simd::TokenCollector collect{text, tokens};
+
+    size_t offset = 0;
+
+#ifdef SPLIT_TEXT_HAS_AVX2_KERNEL
+    if (table.ascii_only && split_simd::has_avx2())
+        offset = split_simd::find_separators_avx2(text, table, collect);
+#endif
+
+    split_simd::find_separators_scalar(text, table, offset, collect);
+    collect.finish();
+
+    return tokens;
+}
+
+#endif // SPLIT_TEXT_SIMD_HPP
@@ -0,0 +1,102 @@
+#ifndef SPLIT_VIEW_HPP
+#define SPLIT_VIEW_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <string_view>
+
+// lazy split_text() - tokens are found while iterating, nothing is allocated; the same tokens as split_text(),
+// empty ones included; the text has to outlive the view and its iterators
+class split_view
+{
+    std::string_view text_;
+    std::string_view separators_;
+
+public:
+    class iterator
+    {
+        static constexpr size_t end_position = std::string_view::npos;
+
+        std::string_view text_;
+        std::string_view separators_;
+        size_t token_start_ = end_position;
+        size_t token_end_ = end_position;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string_view*;
+        using reference = std::string_view; // tokens are made on the fly
+
+        iterator() = default;
+
+        iterator(std::string_view text, std::string_view separators) noexcept
+            : text_{text}, separators_{separators}
+        {
+            if (!text_.empty())
+                find_token(0);
+        }
+
+        std::string_view operator*() const noexcept
+        {
+            return text_.substr(token_start_, token_end_ - token_start_);
+        }
+
+        iterator& operator++() noexcept
+        {
+            // like split_text() - a separator at the very end is not followed by an empty token
+            if (token_end_ >= text_.size() - 1)
+                token_start_ = token_end_ = end_position;
+            else
+                find_token(token_end_ + 1);
+
+            return *this;
+        }
+
+        iterator operator++(int) noexcept
+        {
+            iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        friend bool operator==(const iterator& a, const iterator& b) noexcept
+        {
+            return a.token_start_ == b.token_start_;
+        }
+
+        friend bool operator!=(const iterator& a, const iterator& b) noexcept
+        {
+            return !(a == b);
+        }
+
+    private:
+        void find_token(size_t start) noexcept
+        {
+            // std::find_first_of, as in split_text() - string_view::find_first_of calls char_traits::find for every byte
+            token_start_ = start;
+            token_end_ = std::find_first_of(text_.begin() + start, text_.end(), separators_.begin(), separators_.end()) - text_.begin();
+        }
+    };
+
+    using const_iterator = iterator;
+
+    explicit split_view(std::string_view text, std::string_view separators = " ,;") noexcept
+        : text_{text}, separators_{separators}
+    {
+    }
+
+    iterator begin() const noexcept
+    {
+        return iterator{text_, separators_};
+    }
+
+    iterator end() const noexcept
+    {
+        return iterator{};
+    }
+};
+
+#endif // SPLIT_VIEW_HPP
@@ -1,11 +1,19 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
 #include <algorithm>
 #include <iostream>
+#include <random>
 #include <set>
+#include <thread>
 #include <string>
 #include <string_view>
 #include <vector>
 
 #include "catch.hpp"
+#include "parallel_split.hpp"
+#include "separator_set.hpp"
+#include "split_text_simd.hpp"
+#include "split_view.hpp"
 
 using namespace std;
 
@@ -33,6 +41,28 @@ std::vector<std::string_view> split_text(string_view text, string_view separator
     return tokens;
 }
 
+// the same tokens as split_text() above - every byte is classified with one lookup into the table of the set
+std::vector<std::string_view> split_text(string_view text, const separator_set& separators)
+{
+    std::vector<std::string_view> tokens;
+
+    auto pos1 = cbegin(text);
+
+    while(pos1 != cend(text))
+    {
+        auto pos2 = std::find_if(pos1, cend(text), separators);
+
+        tokens.emplace_back(&(*pos1), pos2 - pos1);
+
+        if (pos2 == cend(text))
+            break;
+
+        pos1 = std::next(pos2);
+    }
+
+    return tokens;
+}
+
 
 TEST_CASE("split with spaces")
 {
@@ -55,3 +85,275 @@ TEST_CASE("split with commas")
 
     REQUIRE(equal(begin(expected), end(expected), begin(words)));
 }
+
+// log-like text of about size bytes - words of 1-12 letters, separated mostly by spaces,
+// with commas, semicolons and runs of separators (empty tokens) mixed in
+string make_log_text(size_t size, unsigned seed = 2020)
+{
+    mt19937 gen{seed};
+    uniform_int_distribution<int> word_length(1, 12);
+    uniform_int_distribution<int> letter('a', 'z');
+    uniform_int_distribution<int> separator(0, 9);
+
+    string text;
+    text.reserve(size + 16);
+
+    while (text.size() < size)
+    {
+        for (int i = word_length(gen); i > 0; --i)
+            text += static_cast<char>(letter(gen));
+
+        switch (separator(gen))
+        {
+        case 0:
+            text += ", ";
+            break;
+        case 1:
+            text += ';';
+            break;
+        case 2:
+            text += ",,";
+            break;
+        default:
+            text += ' ';
+        }
+    }
+
+    return text;
+}
+
+TEST_CASE("split_text_simd - same tokens as split_text")
+{
+    SECTION("edge cases")
+    {
+        for (string_view text : {"", " ", ",,;", "one", " one", "one ", "one  two", ",one,,two;", "\xEF\xBB\xBFone two\x80,three"})
+        {
+            INFO("Text: '" << text << "'");
+            REQUIRE(split_text_simd(text) == split_text(text));
+        }
+    }
+
+    SECTION("every length around the 64-byte blocks")
+    {
+        string text = make_log_text(300);
+
+        for (size_t length = 0; length <= text.size(); ++length)
+        {
+            string_view prefix{text.data(), length};
+            if (split_text_simd(prefix) != split_text(prefix))
+                FAIL("Length: " << length);
+        }
+    }
+
+    SECTION("other separator sets")
+    {
+        string text = make_log_text(100'000);
+
+        REQUIRE(split_text_simd(text, " ") == split_text(text, " "));
+        REQUIRE(split_text_simd(text, "ae") == split_text(text, "ae"));
+        REQUIRE(split_text_simd(text, "") == split_text(text, ""));
+        REQUIRE(split_text_simd(text, "\x80\x7F ") == split_text(text, "\x80\x7F ")); // non-ASCII separator - scalar kernel
+    }
+}
+
+TEST_CASE("split_view - same tokens as split_text")
+{
+    auto lazy_tokens = [](string_view text, string_view separators = " ,;") {
+        vector<string_view> tokens;
+        for (string_view token : split_view{text, separators})
+            tokens.push_back(token);
+        return tokens;
+    };
+
+    for (string_view text : {"", " ", ",,;", "one", " one", "one ", "one  two", ",one,,two;"})
+    {
+        INFO("Text: '" << text << "'");
+        REQUIRE(lazy_tokens(text) == split_text(text));
+    }
+
+    string text = make_log_text(100'000);
+    REQUIRE(lazy_tokens(text) == split_text(text));
+    REQUIRE(lazy_tokens(text, "ae") == split_text(text, "ae"));
+
+    split_view tokens{text};
+    REQUIRE(distance(tokens.begin(), tokens.end()) == static_cast<ptrdiff_t>(split_text(text).size()));
+    REQUIRE(*find(tokens.begin(), tokens.end(), split_text(text)[7]) == split_text(text)[7]);
+    REQUIRE(find(tokens.begin(), tokens.end(), "no such token") == tokens.end());
+}
+
+TEST_CASE("separator_set - built at compile time")
+{
+    constexpr separator_set separators{" ,;"};
+
+    static_assert(separators.size() == 3);
+    static_assert(separators.contains(',') && !separators.contains('a'));
+    static_assert(separator_set{"\xFF\x80"}.contains('\xFF') && !separator_set{"\xFF"}.contains('\x7F'));
+    static_assert(separator_set{}.size() == 0);
+
+    string text = make_log_text(100'000);
+
+    for (string_view set : {"", " ", " ,;", "ae", " ,;.:!?-_/\\|\t\n()"})
+    {
+        INFO("Separators: '" << set << "'");
+        REQUIRE(split_text(text, separator_set{set}) == split_text(text, set));
+    }
+
+    REQUIRE(split_text(",one,,two;", separators) == split_text(",one,,two;"));
+}
+
+TEST_CASE("parallel_split_text - same tokens as split_text")
+{
+    auto concatenated = [](const vector<vector<string_view>>& segments) {
+        vector<string_view> tokens;
+        for (const auto& segment : segments)
+            tokens.insert(tokens.end(), segment.begin(), segment.end());
+        return tokens;
+    };
+
+    SECTION("edge cases")
+    {
+        for (string_view text : {"", " ", ",,;", "one", " one", "one ", "one  two", ",one,,two;", "a b c d e f g h"})
+        {
+            for (size_t threads : {1, 2, 3, 8, 64})
+            {
+                INFO("Text: '" << text << "', threads: " << threads);
+                REQUIRE(parallel_split_text(text, " ,;", threads) == split_text(text));
+                REQUIRE(concatenated(parallel_split_text_segments(text, " ,;", threads)) == split_text(text));
+            }
+        }
+    }
+
+    SECTION("cuts falling on separators, runs of separators and inside tokens")
+    {
+        string text = make_log_text(10'000);
+
+        for (size_t threads = 1; threads <= 97; ++threads)
+        {
+            if (parallel_split_text(text, " ,;", threads) != split_text(text))
+                FAIL("Threads: " << threads);
+        }
+    }
+
+    SECTION("one long token - all cuts move past it")
+    {
+        string text(10'000, 'x');
+        text += " y";
+
+        REQUIRE(parallel_split_text(text, " ,;", 8) == split_text(text));
+        REQUIRE(parallel_split_text_segments(text, " ,;", 8).front().size() == 1);
+    }
+
+    SECTION("other separator sets")
+    {
+        string text = make_log_text(100'000);
+
+        REQUIRE(parallel_split_text(text, "ae", 4) == split_text(text, "ae"));
+        REQUIRE(parallel_split_text(text, "", 4) == split_text(text, ""));
+    }
+}
+
+TEST_CASE("split_text - benchmark", "[!benchmark]")
+{
+    const string text = make_log_text(1'000'000); // about the size of tokens.txt
+
+    BENCHMARK("split_text - std::find_first_of")
+    {
+        return split_text(text);
+    };
+
+    BENCHMARK("split_text_simd - separator bitmask")
+    {
+        return split_text_simd(text);
+    };
+
+    const string_view needle = split_text(text)[10];
+
+    BENCHMARK("count tokens - split_text")
+    {
+        return split_text(text).size();
+    };
+
+    BENCHMARK("count tokens - split_view")
+    {
+        split_view tokens{text};
+        return distance(tokens.begin(), tokens.end());
+    };
+
+    BENCHMARK("find first match - split_text")
+    {
+        auto tokens = split_text(text);
+        return find(tokens.begin(), tokens.end(), needle) != tokens.end();
+    };
+
+    BENCHMARK("find first match - split_view")
+    {
+        split_view tokens{text};
+        return find(tokens.begin(), tokens.end(), needle) != tokens.end();
+    };
+
+    constexpr string_view separators_1 = " ";
+    constexpr string_view separators_3 = " ,;";
+    constexpr string_view separators_16 = " ,;.:!?-_/\\|\t\n()";
+    static_assert(separator_set{separators_16}.size() == 16);
+
+    BENCHMARK("separators: 1 - split_text - std::string_view")
+    {
+        return split_text(text, separators_1);
+    };
+
+    BENCHMARK("separators: 1 - split_text - separator_set")
+    {
+        constexpr separator_set separators{separators_1};
+        return split_text(text, separators);
+    };
+
+    BENCHMARK("separators: 3 - split_text - std::string_view")
+    {
+        return split_text(text, separators_3);
+    };
+
+    BENCHMARK("separators: 3 - split_text - separator_set")
+    {
+        constexpr separator_set separators{separators_3};
+        return split_text(text, separators);
+    };
+
+    BENCHMARK("separators: 16 - split_text - std::string_view")
+    {
+        return split_text(text, separators_16);
+    };
+
+    BENCHMARK("separators: 16 - split_text - separator_set")
+    {
+        constexpr separator_set separators{separators_16};
+        return split_text(text, separators);
+    };
+}
+
+TEST_CASE("parallel_split_text - benchmark", "[!benchmark]")
+{
+    const string text = make_log_text(16'000'000);
+    const size_t max_threads = max(1u, thread::hardware_concurrency());
+
+    // throughput - 16 MB divided by the mean time
+    BENCHMARK("16 MB - split_text")
+    {
+        return split_text(text);
+    };
+
+    for (size_t threads = 1;; threads = min(2 * threads, max_threads))
+    {
+        BENCHMARK("16 MB - parallel - threads: " + to_string(threads))
+        {
+            return parallel_split_text(text, " ,;", threads);
+        };
+
+        BENCHMARK("16 MB - segments - threads: " + to_string(threads))
+        {
+            return parallel_split_text_segments(text, " ,;", threads);
+        };
+
+        if (threads == max_threads)
+            break;
+    }
+}
@@ -0,0 +1,211 @@
+// replaces the global allocation functions, so AllocationTracker sees every operator new of the program
+#include "allocation_tracker.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    void* allocate(std::size_t size)
+    {
+        if (size == 0)
+            size = 1;
+
+        void* ptr = std::malloc(size);
+
+        while (!ptr)
+        {
+            std::new_handler handler = std::get_new_handler();
+            if (!handler)
+                throw std::bad_alloc{};
+
+            handler();
+            ptr = std::malloc(size);
+        }
+
+        if (AllocationTracker::enabled())
+            AllocationTracker::on_allocate(ptr, size);
+
+        return ptr;
+    }
+
+    void* allocate_aligned(std::size_t size, std::align_val_t alignment)
+    {
+        const auto align = static_cast<std::size_t>(alignment);
+        const std::size_t rounded_size = (std::max<std::size_t>(size, 1) + align - 1) / align * align; // required by aligned_alloc
+
+        auto aligned_alloc = [&] {
+#ifdef _MSC_VER
+            return _aligned_malloc(rounded_size, align);
+#else
+            return std::aligned_alloc(align, rounded_size);
+#endif
+        };
+
+        void* ptr = aligned_alloc();
+
+        while (!ptr)
+        {
+            std::new_handler handler = std::get_new_handler();
+            if (!handler)
+                throw std::bad_alloc{};
+
+            handler();
+            ptr = aligned_alloc();
+        }
+
+        if (AllocationTracker::enabled())
+            AllocationTracker::on_allocate(ptr, size);
+
+        return ptr;
+    }
+
+    void deallocate(void* ptr) noexcept
+    {
+        if (ptr && AllocationTracker::enabled())
+            AllocationTracker::on_deallocate(ptr);
+
+        std::free(ptr);
+    }
+
+    void deallocate_aligned(void* ptr) noexcept
+    {
+        if (ptr && AllocationTracker::enabled())
+            AllocationTracker::on_deallocate(ptr);
+
+#ifdef _MSC_VER
+        _aligned_free(ptr);
+#else
+        std::free(ptr);
+#endif
+    }
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return allocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    try
+    {
+        return allocate(size);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    try
+    {
+        return allocate(size);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    return allocate_aligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return allocate_aligned(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    try
+    {
+        return allocate_aligned(size, alignment);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    try
+    {
+        return allocate_aligned(size, alignment);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void operator delete(void* ptr) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+    deallocate_aligned(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept
+{
+    deallocate_aligned(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept
+{
+    deallocate_aligned(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept
+{
+    deallocate_aligned(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    deallocate_aligned(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    deallocate_aligned(ptr);
+}
@@ -0,0 +1,181 @@
+#ifndef ALLOCATION_TRACKER_HPP
+#define ALLOCATION_TRACKER_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#define ALLOCATION_TRACKER_HAS_USABLE_SIZE 1
+#endif
+
+struct AllocationStats
+{
+    uint64_t count = 0;
+    uint64_t bytes = 0;           // as requested from operator new
+    uint64_t peak_live_bytes = 0; // glibc only - the usable size of blocks live at the same time
+};
+
+namespace allocation_tracker_details
+{
+    struct alignas(64) ThreadCounters
+    {
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> bytes{0};
+    };
+} // namespace allocation_tracker_details
+
+// counts heap allocations made through the global operator new, which is replaced in allocation_tracker.cpp;
+// disabled it costs one relaxed load per allocation - counts and bytes are kept per thread,
+// live bytes in one shared counter, so tracking is global and start()/stop() must not be nested
+class AllocationTracker
+{
+    using ThreadCounters = allocation_tracker_details::ThreadCounters;
+
+    static constexpr size_t max_no_of_threads = 256; // alive at the same time - the threads above share the last slot
+    static constexpr size_t shared_slot = max_no_of_threads - 1;
+
+    inline static std::atomic<bool> enabled_{false};
+    inline static std::array<ThreadCounters, max_no_of_threads> threads_{};
+    inline static std::array<std::atomic<bool>, shared_slot> slot_taken_{};
+    inline static std::atomic<int64_t> live_bytes_{0};
+    inline static std::atomic<int64_t> peak_live_bytes_{0};
+
+    // no allocation here - it is called from operator new; a slot is returned when its thread exits, so threads
+    // created per task do not use the slots up - allocations after that (thread teardown) go to the shared slot
+    static ThreadCounters& this_thread_counters() noexcept
+    {
+        thread_local ThreadCounters* counters = nullptr;
+
+        struct SlotRelease
+        {
+            size_t index;
+
+            ~SlotRelease()
+            {
+                counters = &threads_[shared_slot];
+                slot_taken_[index].store(false, std::memory_order_release);
+            }
+        };
+
+        if (!counters)
+        {
+            counters = &threads_[shared_slot];
+
+            for (size_t index = 0; index < shared_slot; ++index)
+            {
+                bool taken = false;
+                if (!slot_taken_[index].load(std::memory_order_relaxed)
+                    && slot_taken_[index].compare_exchange_strong(taken, true, std::memory_order_acquire))
+                {
+                    counters = &threads_[index];
+                    thread_local SlotRelease release{index};
+                    break;
+                }
+            }
+        }
+
+        return *counters;
+    }
+
+public:
+    static bool enabled() noexcept
+    {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    // zeroes all counters and starts counting
+    static void start() noexcept
+    {
+        for (auto& counters : threads_)
+        {
+            counters.count.store(0, std::memory_order_relaxed);
+            counters.bytes.store(0, std::memory_order_relaxed);
+        }
+
+        live_bytes_.store(0, std::memory_order_relaxed);
+        peak_live_bytes_.store(0, std::memory_order_relaxed);
+        enabled_.store(true, std::memory_order_release);
+    }
+
+    static AllocationStats stop() noexcept
+    {
+        enabled_.store(false, std::memory_order_release);
+        return read();
+    }
+
+    static AllocationStats read() noexcept
+    {
+        AllocationStats stats;
+
+        for (const auto& counters : threads_)
+        {
+            stats.count += counters.count.load(std::memory_order_relaxed);
+            stats.bytes += counters.bytes.load(std::memory_order_relaxed);
+        }
+
+        stats.peak_live_bytes = static_cast<uint64_t>(peak_live_bytes_.load(std::memory_order_relaxed));
+        return stats;
+    }
+
+    static void on_allocate(void* ptr, size_t size) noexcept
+    {
+        auto& counters = this_thread_counters();
+
+        // read-modify-write even on an own slot - start() zeroes the slots from another thread, and a plain
+        // load and store racing with it could bring the count of the previous run back; cheap next to malloc
+        counters.count.fetch_add(1, std::memory_order_relaxed);
+        counters.bytes.fetch_add(size, std::memory_order_relaxed);
+
+#ifdef ALLOCATION_TRACKER_HAS_USABLE_SIZE
+        const int64_t size_of_block = static_cast<int64_t>(::malloc_usable_size(ptr));
+        const int64_t live = live_bytes_.fetch_add(size_of_block, std::memory_order_relaxed) + size_of_block;
+
+        for (int64_t peak = peak_live_bytes_.load(std::memory_order_relaxed);
+             live > peak && !peak_live_bytes_.compare_exchange_weak(peak, live, std::memory_order_relaxed);)
+        {
+        }
+#else
+        (void)ptr;
+#endif
+    }
+
+    // blocks allocated before start() are not in the live bytes - freeing them clamps the live bytes at zero,
+    // so they do not lower the peak of the blocks allocated after start()
+    static void on_deallocate(void* ptr) noexcept
+    {
+#ifdef ALLOCATION_TRACKER_HAS_USABLE_SIZE
+        const int64_t size_of_block = static_cast<int64_t>(::malloc_usable_size(ptr));
+
+        for (int64_t live = live_bytes_.load(std::memory_order_relaxed);
+             !live_bytes_.compare_exchange_weak(live, std::max<int64_t>(live - size_of_block, 0), std::memory_order_relaxed);)
+        {
+        }
+#else
+        (void)ptr;
+#endif
+    }
+};
+
+// counts the allocations made while f runs
+template <typename F>
+AllocationStats count_allocations(F&& f)
+{
+    struct StopOnExit
+    {
+        ~StopOnExit()
+        {
+            AllocationTracker::stop();
+        }
+    };
+
+    AllocationTracker::start();
+    StopOnExit stop_on_exception;
+    f();
+    return AllocationTracker::stop();
+}
+
+#endif // ALLOCATION_TRACKER_HPP
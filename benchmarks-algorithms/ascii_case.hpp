@@ -0,0 +1,115 @@
+#ifndef ASCII_CASE_HPP
+#define ASCII_CASE_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define ASCII_CASE_HAS_X86_KERNELS 1
+#endif
+
+// lowercases 'A'..'Z' only - bytes >= 0x80 (UTF-8 sequences like the BOM of tokens.txt) are copied unchanged,
+// which is what boost::to_lower does in the classic locale
+namespace ascii_case
+{
+    constexpr char to_lower(char c) noexcept
+    {
+        return static_cast<unsigned char>(c - 'A') < 26 ? static_cast<char>(c | 0x20) : c;
+    }
+
+    // kernels read src and write dst - both may point to the same buffer
+    using Kernel = void (*)(const char* src, char* dst, size_t size);
+
+    inline void to_lower_scalar(const char* src, char* dst, size_t size) noexcept
+    {
+        for (size_t i = 0; i < size; ++i)
+            dst[i] = to_lower(src[i]);
+    }
+
+#ifdef ASCII_CASE_HAS_X86_KERNELS
+    // signed comparison - bytes >= 0x80 are negative, so they never fall into 'A'..'Z'
+    __attribute__((target("sse2"))) inline void to_lower_sse2(const char* src, char* dst, size_t size) noexcept
+    {
+        const __m128i before_a = _mm_set1_epi8('A' - 1);
+        const __m128i after_z = _mm_set1_epi8('Z' + 1);
+        const __m128i case_bit = _mm_set1_epi8(0x20);
+
+        size_t i = 0;
+        for (; i + 16 <= size; i += 16)
+        {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            __m128i is_upper = _mm_and_si128(_mm_cmpgt_epi8(chunk, before_a), _mm_cmplt_epi8(chunk, after_z));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_or_si128(chunk, _mm_and_si128(is_upper, case_bit)));
+        }
+
+        to_lower_scalar(src + i, dst + i, size - i);
+    }
+
+    __attribute__((target("avx2"))) inline void to_lower_avx2(const char* src, char* dst, size_t size) noexcept
+    {
+        const __m256i before_a = _mm256_set1_epi8('A' - 1);
+        const __m256i z = _mm256_set1_epi8('Z');
+        const __m256i case_bit = _mm256_set1_epi8(0x20);
+
+        size_t i = 0;
+        for (; i + 32 <= size; i += 32)
+        {
+            __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+            __m256i is_upper = _mm256_andnot_si256(_mm256_cmpgt_epi8(chunk, z), _mm256_cmpgt_epi8(chunk, before_a));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_or_si256(chunk, _mm256_and_si256(is_upper, case_bit)));
+        }
+
+        to_lower_sse2(src + i, dst + i, size - i);
+    }
+#endif
+
+    struct KernelInfo
+    {
+        Kernel kernel;
+        const char* name;
+    };
+
+    inline KernelInfo select_kernel() noexcept
+    {
+#ifdef ASCII_CASE_HAS_X86_KERNELS
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("avx2"))
+            return {to_lower_avx2, "avx2"};
+
+        if (__builtin_cpu_supports("sse2"))
+            return {to_lower_sse2, "sse2"};
+#endif
+        return {to_lower_scalar, "scalar"};
+    }
+
+    // chosen once at startup for the CPU the program runs on
+    inline const KernelInfo active_kernel = select_kernel();
+} // namespace ascii_case
+
+inline void to_lower_ascii(char* first, char* last) noexcept
+{
+    ascii_case::active_kernel.kernel(first, first, last - first);
+}
+
+inline void to_lower_ascii(std::string& text) noexcept
+{
+    to_lower_ascii(text.data(), text.data() + text.size());
+}
+
+// writes text.size() bytes to out
+inline void to_lower_ascii_copy(std::string_view text, char* out) noexcept
+{
+    ascii_case::active_kernel.kernel(text.data(), out, text.size());
+}
+
+inline std::string to_lower_ascii_copy(std::string_view text)
+{
+    std::string result(text.size(), '\0');
+    to_lower_ascii_copy(text, result.data());
+    return result;
+}
+
+#endif // ASCII_CASE_HPP
@@ -3,13 +3,37 @@
 
 #include <algorithm>
 #include <boost/algorithm/string.hpp>
+#include <chrono>
 #include <cmath>
+#include <cstdio>
 #include <execution>
 #include <fstream>
 #include <iostream>
+#include <iterator>
 #include <random>
+#include <sstream>
 #include <string>
 #include <thread>
+#include <unordered_set>
+
+#include "allocation_tracker.hpp"
+#include "ascii_case.hpp"
+#include "blocked_scan.hpp"
+#include "benchmark_results.hpp"
+#include "benchmark_sweep.hpp"
+#include "collation.hpp"
+#include "corpus.hpp"
+#include "datasets.hpp"
+#include "heavy_hitters.hpp"
+#include "miller_rabin.hpp"
+#include "prime_sieve.hpp"
+#include "process_memory.hpp"
+#include "radix_sort.hpp"
+#include "stable_partition.hpp"
+#include "string_hash.hpp"
+#include "token_table.hpp"
+#include "word_count.hpp"
+#include "work_stealing_pool.hpp"
 
 std::vector<std::string> load_words(const std::string& file_name)
 {
@@ -29,10 +53,289 @@ std::vector<std::string> load_words(const std::string& file_name)
     return words;
 }
 
-inline const std::vector<std::string> words = [] { auto words = load_words("tokens.txt"); words.resize(words.size() / 10);  return words; }();
+// fraction of the corpus - above 1 the corpus is replicated
+std::vector<std::string> scaled_words(double scale)
+{
+    static const std::vector<std::string> all_words = load_words("tokens.txt");
+
+    auto no_of_words = static_cast<size_t>(all_words.size() * scale);
+
+    std::vector<std::string> words;
+    words.reserve(no_of_words);
+    while (words.size() < no_of_words)
+        words.insert(words.end(), all_words.begin(), all_words.begin() + std::min(all_words.size(), no_of_words - words.size()));
+
+    return words;
+}
+
+// resized by the sweep mode (--sweep-scales) - constant for the duration of a run
+inline std::vector<std::string> words = scaled_words(BenchmarkSweep::default_dataset_scale);
+
+inline TokenTable words_table{words.begin(), words.end()};
+
+// sized to the current thread limit, so the sweep mode (--sweep-threads) applies to it as well
+WorkStealingPool& benchmark_pool()
+{
+    static std::unique_ptr<WorkStealingPool> pool;
+
+    if (!pool || pool->size() != BenchmarkResults::thread_count())
+        pool = std::make_unique<WorkStealingPool>(BenchmarkResults::thread_count());
+
+    return *pool;
+}
+
+inline const bool words_registered = BenchmarkSweep::register_dataset([](double scale) {
+    words = scaled_words(scale);
+    words_table = TokenTable{words.begin(), words.end()};
+});
+
+TEST_CASE("BenchmarkResults - baseline round trip and regressions")
+{
+    BenchmarkResults baseline;
+    baseline.add(BenchmarkRecord{"std::sort - \"quoted\"", 100.0, 2.0, 97.0, 100, 8, 1000});
+    baseline.add(BenchmarkRecord{"std::sort - parallel", 100.0, 2.0, 97.0, 100, 8, 1000});
+    baseline.add(BenchmarkRecord{"noisy", 100.0, 50.0, 40.0, 10, 8, 1000});
+    baseline.add(BenchmarkRecord{"allocation free", 100.0, 2.0, 97.0, 100, 8, 1000, 0.01});
+
+    const std::string file_name = "benchmark_results_test.json";
+    baseline.write(file_name);
+    auto loaded = BenchmarkResults::load_json(file_name);
+    std::remove(file_name.c_str());
+
+    REQUIRE(loaded.size() == 4);
+    REQUIRE(loaded[0].name == "std::sort - \"quoted\"");
+    REQUIRE(loaded[0].mean_ns == 100.0);
+    REQUIRE(loaded[0].dataset_size == 1000);
+    REQUIRE_FALSE(loaded[0].allocations);
+    REQUIRE(loaded[3].allocations == 0.01);
+
+    BenchmarkResults current;
+    current.add(BenchmarkRecord{"std::sort - \"quoted\"", 102.0, 2.0, 99.0, 100, 8, 1000}); // within threshold
+    current.add(BenchmarkRecord{"std::sort - parallel", 110.0, 2.0, 107.0, 100, 8, 1000});  // regression
+    current.add(BenchmarkRecord{"noisy", 120.0, 50.0, 60.0, 10, 8, 1000});                  // not significant
+    current.add(BenchmarkRecord{"std::sort - parallel", 200.0, 2.0, 197.0, 100, 1, 1000});  // other thread count - no baseline
+    current.add(BenchmarkRecord{"allocation free", 100.0, 2.0, 97.0, 100, 8, 1000, 3.0});    // started allocating
+
+    auto regressions = current.compare(loaded, 0.05);
+
+    REQUIRE(regressions.size() == 2);
+    REQUIRE(regressions[0].current.name == "std::sort - parallel");
+    REQUIRE(regressions[0].slowdown == Approx(0.1));
+    REQUIRE(regressions[1].current.name == "allocation free");
+    REQUIRE(regressions[1].started_allocating);
+}
+
+TEST_CASE("load_words_mapped - same tokens as load_words")
+{
+    auto all_words = load_words("tokens.txt");
+    auto mapped_words = load_words_mapped("tokens.txt");
+
+    REQUIRE(std::equal(all_words.begin(), all_words.end(), mapped_words.begin(), mapped_words.end()));
+}
+
+TEST_CASE("load_words_parallel - same tokens as load_words")
+{
+    auto all_words = load_words("tokens.txt");
+
+    for (size_t no_of_threads : {1u, 2u, 3u, 8u, 64u})
+    {
+        auto parallel_words = load_words_parallel("tokens.txt", no_of_threads);
+
+        INFO("No of threads: " << no_of_threads);
+        REQUIRE(std::equal(all_words.begin(), all_words.end(), parallel_words.begin(), parallel_words.end()));
+    }
+}
+
+TEST_CASE("tokenize_words - same tokens as operator>> around the 64-byte blocks")
+{
+    std::mt19937 gen{2020};
+    std::uniform_int_distribution<int> byte_value(0, 255);
+    const std::string separators = " \t\n\v\f\r";
+
+    std::string text;
+    for (size_t i = 0; i < 400; ++i)
+        text += gen() % 3 == 0 ? separators[gen() % separators.size()] : static_cast<char>(byte_value(gen)); // separators, runs and high bytes
+
+    for (size_t length = 0; length <= text.size(); ++length)
+    {
+        std::string_view prefix{text.data(), length};
+
+        std::istringstream input{std::string{prefix}};
+        std::vector<std::string> expected{std::istream_iterator<std::string>{input}, std::istream_iterator<std::string>{}};
+
+        std::vector<std::string_view> words;
+        tokenize_words(prefix, words);
+
+        if (!std::equal(words.begin(), words.end(), expected.begin(), expected.end()))
+            FAIL("Length: " << length);
+    }
+}
+
+TEST_CASE("tokenize_words_parallel - edge cases")
+{
+    REQUIRE(tokenize_words_parallel("", 4).empty());
+    REQUIRE(tokenize_words_parallel("  \n\t ", 4).empty());
+    REQUIRE(tokenize_words_parallel("one", 8) == std::vector<std::string_view>{"one"});
+    REQUIRE(tokenize_words_parallel(" one  two\nthree ", 16) == std::vector<std::string_view>{"one", "two", "three"});
+}
+
+TEST_CASE("load words")
+{
+    benchmark_results().set_dataset_size(MappedFile{"tokens.txt"}.content().size());
+
+    auto print_peak_rss = [](std::string_view loader_name, auto loader) {
+        std::cout << "Peak RSS growth - " << loader_name << ": ";
+        if (auto rss_kb = peak_rss_growth_kb(loader))
+            std::cout << *rss_kb << " kB\n";
+        else
+            std::cout << "n/a\n";
+    };
+
+    print_peak_rss("load_words", [] { return load_words("tokens.txt"); });
+    print_peak_rss("load_words_mapped", [] { return load_words_mapped("tokens.txt"); });
+
+    BENCHMARK("load_words - ifstream >> std::string")
+    {
+        return load_words("tokens.txt");
+    };
+
+    BENCHMARK("load_words_mapped - mmap + std::string_view")
+    {
+        return load_words_mapped("tokens.txt");
+    };
+
+    const size_t max_no_of_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (size_t no_of_threads = 1; no_of_threads < 2 * max_no_of_threads; no_of_threads *= 2)
+    {
+        no_of_threads = std::min(no_of_threads, max_no_of_threads);
+
+        BENCHMARK("load_words_parallel - threads: " + std::to_string(no_of_threads))
+        {
+            return load_words_parallel("tokens.txt", no_of_threads);
+        };
+    }
+}
+
+TEST_CASE("stream_words - same tokens as load_words")
+{
+    auto streamed_words = [](const std::string& file_name, size_t buffer_size) {
+        std::vector<std::string> words;
+        stream_words(
+            file_name, [&](const std::vector<std::string_view>& batch) { words.insert(words.end(), batch.begin(), batch.end()); }, buffer_size);
+        return words;
+    };
+
+    SECTION("tokens.txt - tokens cut by the buffer end are carried over")
+    {
+        auto all_words = load_words("tokens.txt");
+
+        for (size_t buffer_size : {1u, 7u, 4096u, 1u << 20}) // 1 - the buffer grows to the longest token
+        {
+            INFO("Buffer size: " << buffer_size);
+            REQUIRE(streamed_words("tokens.txt", buffer_size) == all_words);
+        }
+    }
+
+    SECTION("edge cases")
+    {
+        const std::string file_name = "stream_words_test.txt";
+
+        for (std::string_view text : {"", " \n\t ", "one", "  one two\n", "one  two\nthree", "averyveryverylongtoken short"})
+        {
+            std::ofstream{file_name, std::ios::binary} << text;
+
+            for (size_t buffer_size : {1u, 3u, 4096u})
+            {
+                INFO("Text: '" << text << "', buffer size: " << buffer_size);
+                REQUIRE(streamed_words(file_name, buffer_size) == load_words(file_name));
+            }
+        }
+
+        std::remove(file_name.c_str());
+    }
+
+    REQUIRE_THROWS_AS(stream_words("no_such_file.txt", [](const auto&) {}), std::runtime_error);
+}
+
+TEST_CASE("stream words")
+{
+    // tokens.txt replicated - copies scaled down from the multi-GB case to keep the run short
+    const std::string file_name = "tokens_replicated.txt";
+    constexpr size_t no_of_copies = 16;
+
+    {
+        const MappedFile tokens{"tokens.txt"};
+        std::ofstream replicated{file_name, std::ios::binary};
+        for (size_t i = 0; i < no_of_copies; ++i)
+            replicated.write(tokens.content().data(), tokens.content().size());
+    }
+
+    const size_t file_size = MappedFile{file_name}.content().size();
+    benchmark_results().set_dataset_size(file_size);
+
+    std::cout << "Replicated tokens.txt: " << file_size / (1024 * 1024) << " MB\n";
+
+    auto count_streamed_words = [&](size_t buffer_size) {
+        return stream_words(file_name, [](const std::vector<std::string_view>&) {}, buffer_size);
+    };
+
+    auto print_peak_rss = [](std::string_view loader_name, auto loader) {
+        std::cout << "Peak RSS growth - " << loader_name << ": ";
+        if (auto rss_kb = peak_rss_growth_kb(loader))
+            std::cout << *rss_kb << " kB\n";
+        else
+            std::cout << "n/a\n";
+    };
+
+    print_peak_rss("stream_words - 1 MB buffer", [&] { return count_streamed_words(1 << 20); });
+    print_peak_rss("load_words_mapped", [&] { return load_words_mapped(file_name); });
+
+    // upper bound - the same reads without tokenizing
+    BENCHMARK("read file - ifstream::read, 1 MB buffer")
+    {
+        std::ifstream input_file{file_name, std::ios::binary};
+        std::vector<char> buffer(1 << 20);
+        size_t size = 0;
+        while (input_file.read(buffer.data(), buffer.size()) || input_file.gcount() > 0)
+            size += input_file.gcount();
+        return size;
+    };
+
+    for (size_t buffer_size : {64u << 10, 1u << 20, 16u << 20})
+    {
+        BENCHMARK("stream_words - buffer: " + std::to_string(buffer_size >> 10) + " kB")
+        {
+            return count_streamed_words(buffer_size);
+        };
+    }
+
+    BENCHMARK("load_words_mapped - whole file")
+    {
+        return load_words_mapped(file_name).size();
+    };
+
+    std::remove(file_name.c_str());
+}
+
+TEST_CASE("TokenTable - same words as std::vector<std::string>")
+{
+    REQUIRE(words_table.size() == words.size());
+    REQUIRE(std::equal(words.begin(), words.end(), words_table.begin(), words_table.end()));
+    REQUIRE(words_table[words.size() / 2] == words[words.size() / 2]);
+
+    auto sorted_table = words_table;
+    auto sorted_words = words;
+    sorted_table.sort(std::execution::par, std::less<>{});
+    std::sort(sorted_words.begin(), sorted_words.end());
+
+    REQUIRE(std::equal(sorted_words.begin(), sorted_words.end(), sorted_table.begin(), sorted_table.end()));
+}
 
 TEST_CASE("accumulate")
 {
+    benchmark_results().set_dataset_size(words.size());
+
     std::cout << "No of cores: " << std::thread::hardware_concurrency() << "\n";
     std::cout << "No of words: " << words.size() << std::endl;
 
@@ -50,139 +353,1396 @@ TEST_CASE("accumulate")
     {
         return std::transform_reduce(std::execution::par_unseq, words.begin(), words.end(), 0ULL, std::plus{}, [](const auto& word) { return std::hash<std::string>{}(word); });
     };
+
+    BENCHMARK("std::accumulate - TokenTable")
+    {
+        return std::accumulate(words_table.begin(), words_table.end(), 0ULL, [](const auto& total, const auto& word) { return total + std::hash<std::string_view>{}(word); });
+    };
+
+    BENCHMARK("std::transform_reduce - parallel - TokenTable")
+    {
+        return std::transform_reduce(std::execution::par, words_table.begin(), words_table.end(), 0ULL, std::plus{}, [](const auto& word) { return std::hash<std::string_view>{}(word); });
+    };
+
+    BENCHMARK("std::transform_reduce - parallel unsequenced - TokenTable")
+    {
+        return std::transform_reduce(std::execution::par_unseq, words_table.begin(), words_table.end(), 0ULL, std::plus{}, [](const auto& word) { return std::hash<std::string_view>{}(word); });
+    };
+
+    BENCHMARK("parallel_transform_reduce - work-stealing pool")
+    {
+        return parallel_transform_reduce(benchmark_pool(), words.begin(), words.end(), 0ULL, std::plus{}, [](const auto& word) { return std::hash<std::string>{}(word); });
+    };
 }
 
-TEST_CASE("sort")
+TEST_CASE("to_lower_ascii - same result as boost::to_lower")
 {
-    SECTION("sequenced")
-    {
-        auto words_to_sort = words;
-        REQUIRE_FALSE(std::is_sorted(words_to_sort.begin(), words_to_sort.end()));
+    std::string all_bytes;
+    for (int i = 0; i < 3 * 256; ++i)
+        all_bytes.push_back(static_cast<char>(i % 256));
 
-        BENCHMARK("std::sort")
+    // every length and offset exercises the vector loop and the scalar tail
+    for (size_t offset = 0; offset < 33; ++offset)
+    {
+        for (size_t length : {0, 1, 15, 16, 17, 31, 32, 33, 100, 700})
         {
-            std::sort(words_to_sort.begin(), words_to_sort.end(), [](const auto& a, const auto& b) { return boost::to_lower_copy(a) < boost::to_lower_copy(b); });
-            return words_to_sort.front();
-        };
+            std::string_view text = std::string_view{all_bytes}.substr(offset, length);
+
+            auto expected = boost::to_lower_copy(std::string{text});
+            REQUIRE(to_lower_ascii_copy(text) == expected);
+
+            std::string in_place{text};
+            to_lower_ascii(in_place);
+            REQUIRE(in_place == expected);
+        }
     }
 
-    SECTION("parallel")
+    MappedFile corpus{"tokens.txt"};
+    REQUIRE(to_lower_ascii_copy(corpus.content()) == boost::to_lower_copy(std::string{corpus.content()}));
+    REQUIRE(to_lower_ascii_copy(corpus.content()).compare(0, 3, "\xEF\xBB\xBF") == 0); // BOM left intact
+}
+
+TEST_CASE("to lower")
+{
+    std::cout << "ASCII lowercase kernel: " << ascii_case::active_kernel.name << "\n";
+
+    MappedFile corpus{"tokens.txt"};
+    std::string text{corpus.content()};
+    benchmark_results().set_dataset_size(text.size());
+
+    BENCHMARK("boost::to_lower - corpus")
     {
-        auto words_to_sort = words;
-        REQUIRE_FALSE(std::is_sorted(words_to_sort.begin(), words_to_sort.end()));
+        boost::to_lower(text);
+        return text.size();
+    };
 
-        BENCHMARK("std::sort - parallel")
-        {
-            std::sort(
-                std::execution::par,
-                words_to_sort.begin(), words_to_sort.end(),
-                [](const auto& a, const auto& b) { return boost::to_lower_copy(a) < boost::to_lower_copy(b); });
+    BENCHMARK("std::tolower loop - corpus")
+    {
+        std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return text.size();
+    };
 
-            return words_to_sort.front();
-        };
-    }
+    BENCHMARK("to_lower_ascii - corpus")
+    {
+        to_lower_ascii(text);
+        return text.size();
+    };
 
-    SECTION("parallel unsequenced")
+    std::string lowered(text.size(), '\0');
+
+    BENCHMARK("to_lower_ascii_copy - corpus")
     {
-        auto words_to_sort = words;
-        REQUIRE_FALSE(std::is_sorted(words_to_sort.begin(), words_to_sort.end()));
+        to_lower_ascii_copy(text, lowered.data());
+        return lowered.size();
+    };
 
-        BENCHMARK("std::sort - parallel unseqenced")
-        {
-            std::for_each(std::execution::par, words_to_sort.begin(), words_to_sort.end(), [](auto& w) { boost::to_lower(w); });
-            std::vector<std::string_view> words_views(words_to_sort.size());
-            std::transform(std::execution::par, words_to_sort.begin(), words_to_sort.end(), words_views.begin(), [](const auto& w) { return std::string_view(w); });
+    auto words_to_lower = words;
 
-            std::sort(
-                std::execution::par_unseq,
-                words_views.begin(), words_views.end());
+    BENCHMARK("boost::to_lower - words - parallel")
+    {
+        std::for_each(std::execution::par, words_to_lower.begin(), words_to_lower.end(), [](auto& w) { boost::to_lower(w); });
+        return words_to_lower.size();
+    };
 
-            return std::string(words_views.front());
-        };
-    }
+    BENCHMARK("to_lower_ascii - words - parallel")
+    {
+        std::for_each(std::execution::par, words_to_lower.begin(), words_to_lower.end(), [](auto& w) { to_lower_ascii(w); });
+        return words_to_lower.size();
+    };
 }
 
-bool is_prime(uint64_t number)
+TEMPLATE_TEST_CASE("hashers - every prefix length hashes differently", "", StdHash, Fnv1aHash, WyHash)
 {
-    if (number < 2)
+    const std::string text = "The quick brown fox jumps over the lazy dog; pack my box with five dozen liquor jugs";
+
+    std::unordered_set<size_t> hashes;
+    for (size_t length = 0; length <= text.size(); ++length)
     {
-        return false;
+        auto hash = TestType{}(std::string_view{text}.substr(0, length));
+        REQUIRE(hash == TestType{}(std::string{text, 0, length}));
+        hashes.insert(hash);
     }
-    else if (number % 2 == 0 && number != 2)
+
+    REQUIRE(hashes.size() == text.size() + 1);
+}
+
+TEMPLATE_TEST_CASE("accumulate - hasher", "", StdHash, Fnv1aHash, WyHash)
+{
+    benchmark_results().set_dataset_size(words.size());
+
+    using Hasher = TestType;
+    const std::string hasher_name = Hasher::name;
+
+    BENCHMARK("std::accumulate - " + hasher_name)
     {
-        return false;
+        return std::accumulate(words.begin(), words.end(), 0ULL, [](const auto& total, const auto& word) { return total + Hasher{}(word); });
+    };
+
+    BENCHMARK("std::transform_reduce - parallel - " + hasher_name)
+    {
+        return std::transform_reduce(std::execution::par, words.begin(), words.end(), 0ULL, std::plus{}, [](const auto& word) { return Hasher{}(word); });
+    };
+
+    BENCHMARK("std::transform_reduce - parallel unsequenced - " + hasher_name)
+    {
+        return std::transform_reduce(std::execution::par_unseq, words.begin(), words.end(), 0ULL, std::plus{}, [](const auto& word) { return Hasher{}(word); });
+    };
+}
+
+TEMPLATE_TEST_CASE("hashers - throughput and collisions on tokens.txt", "", StdHash, Fnv1aHash, WyHash)
+{
+    using Hasher = TestType;
+
+    auto all_words = load_words_mapped("tokens.txt");
+
+    size_t no_of_bytes = 0;
+    for (auto word : all_words)
+        no_of_bytes += word.size();
+
+    constexpr int no_of_rounds = 20;
+    size_t checksum = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < no_of_rounds; ++i)
+    {
+        for (auto word : all_words)
+            checksum += Hasher{}(word);
     }
-    else
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::unordered_set<std::string_view> distinct_words(all_words.begin(), all_words.end());
+    std::unordered_set<uint64_t> hashes;
+    std::unordered_set<uint32_t> hashes_32;
+    for (auto word : distinct_words)
     {
-        for (uint64_t i = 3; i <= sqrt(number); i += 2)
-        {
-            if (number % i == 0)
-                return false;
-        }
-        return true;
+        hashes.insert(Hasher{}(word));
+        hashes_32.insert(static_cast<uint32_t>(Hasher{}(word)));
     }
+
+    std::cout << Hasher::name << " - " << no_of_rounds * no_of_bytes / elapsed.count() / 1e9 << " GB/s"
+              << ", collisions: " << distinct_words.size() - hashes.size()
+              << " (low 32 bits: " << distinct_words.size() - hashes_32.size() << ")"
+              << " of " << distinct_words.size() << " distinct words"
+              << " [checksum: " << checksum << "]\n";
+
+    REQUIRE(hashes.size() == distinct_words.size());
 }
 
-const size_t no_of_items = 20'000;
+TEST_CASE("word counts - parallel modes give the same counts as std::unordered_map")
+{
+    auto all_words = load_words_mapped("tokens.txt");
+    auto expected = count_words(all_words);
 
-const std::vector<uint64_t> numbers = [] {
-    std::random_device rd;
-    std::mt19937_64 rnd_gen{rd()};
-    std::uniform_int_distribution<uint64_t> rnd_distr(0, no_of_items);
+    size_t no_of_threads = GENERATE(1u, 3u, 8u);
+    INFO("No of threads: " << no_of_threads);
 
-    std::vector<uint64_t> numbers(no_of_items);
-    std::generate(numbers.begin(), numbers.end(), [&] { return rnd_distr(rnd_gen); });
+    REQUIRE(count_words_local_maps(all_words, no_of_threads) == expected);
+    REQUIRE(count_words_sharded(all_words, no_of_threads, 7) == expected);
 
-    return numbers;
-}();
+    auto expected_wyhash = count_words<WyHash>(all_words);
+    REQUIRE(count_words_local_maps<WyHash>(all_words, no_of_threads) == expected_wyhash);
+    REQUIRE(count_words_sharded<WyHash>(all_words, no_of_threads, 7) == expected_wyhash);
 
-TEST_CASE("transform")
+    std::vector<std::string_view> no_words;
+    REQUIRE(count_words_local_maps(no_words, no_of_threads).empty());
+    REQUIRE(count_words_sharded(no_words, no_of_threads).empty());
+}
+
+TEST_CASE("word counts")
 {
-    SECTION("sequenced")
+    auto all_words = load_words_mapped("tokens.txt");
+    benchmark_results().set_dataset_size(all_words.size());
+
+    BENCHMARK("word counts - std::unordered_map - single thread")
     {
-        auto numbers_to_part = numbers;
-        decltype(numbers_to_part) are_primes(numbers_to_part.size());
+        return count_words(all_words);
+    };
 
-        BENCHMARK("transform - sequenced")
-        {
-            std::transform(numbers_to_part.begin(), numbers_to_part.end(), are_primes.begin(), [](auto n) { return is_prime(n); });
-            return are_primes;
-        };
-    }
+    BENCHMARK("word counts - std::unordered_map - single thread - WyHash")
+    {
+        return count_words<WyHash>(all_words);
+    };
 
-    SECTION("parallel")
+    const size_t max_no_of_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (size_t no_of_threads = 1; no_of_threads < 2 * max_no_of_threads; no_of_threads *= 2)
     {
-        auto numbers_to_part = numbers;
-        decltype(numbers_to_part) are_primes(numbers_to_part.size());
+        no_of_threads = std::min(no_of_threads, max_no_of_threads);
 
+        BENCHMARK("word counts - local maps - threads: " + std::to_string(no_of_threads))
+        {
+            return count_words_local_maps(all_words, no_of_threads);
+        };
 
-        BENCHMARK("transform - parallel")
+        BENCHMARK("word counts - sharded map - threads: " + std::to_string(no_of_threads))
         {
-            std::transform(std::execution::par_unseq, numbers_to_part.begin(), numbers_to_part.end(), are_primes.begin(), [](auto n) { return is_prime(n); });
-            return are_primes;
+            return count_words_sharded(all_words, no_of_threads);
         };
     }
 }
 
-TEST_CASE("partition")
+TEST_CASE("HeavyHitters - error bounds against exact counts on tokens.txt")
 {
-    SECTION("sequenced")
-    {
-        auto numbers_to_part = numbers;
+    auto all_words = load_words_mapped("tokens.txt");
+    auto exact = count_words(all_words);
 
-        BENCHMARK("partition - sequenced")
-        {
-            return std::partition(numbers_to_part.begin(), numbers_to_part.end(), [](auto n) { return is_prime(n); });
-        };
-    }
+    constexpr size_t k = 20;
+    size_t no_of_threads = GENERATE(1u, 4u);
+    INFO("No of threads: " << no_of_threads);
 
-    SECTION("parallel")
+    auto heavy_hitters = heavy_hitters_parallel(all_words, no_of_threads, k, 4096, 4);
+    const auto& sketch = heavy_hitters.sketch();
+
+    REQUIRE(sketch.total() == all_words.size());
+
+    std::vector<std::pair<std::string_view, size_t>> exact_top(exact.begin(), exact.end());
+    std::partial_sort(exact_top.begin(), exact_top.begin() + k, exact_top.end(), [](const auto& a, const auto& b) { return a.second > b.second; });
+    exact_top.resize(k);
+
+    uint64_t max_error = 0;
+    size_t no_of_exact_top_found = 0;
+    auto top = heavy_hitters.top();
+
+    for (const auto& [word, estimate] : top)
     {
-        auto numbers_to_part = numbers;
+        REQUIRE(estimate >= exact[word]); // never undercounts
+        max_error = std::max(max_error, estimate - exact[word]);
+    }
 
-        BENCHMARK("partition - parallel")
+    for (const auto& [word, count] : exact_top)
+        no_of_exact_top_found += std::count_if(top.begin(), top.end(), [word = word](const auto& t) { return t.first == word; });
+
+    std::cout << "HeavyHitters - threads: " << no_of_threads << ", sketch " << sketch.width() << " x " << sketch.depth()
+              << " (" << sketch.memory_bytes() / 1024 << " kB), max overcount in top " << k << ": " << max_error
+              << ", bound: " << sketch.error_bound() << " with probability " << 1 - sketch.delta()
+              << ", exact top " << k << " found: " << no_of_exact_top_found << "\n";
+
+    REQUIRE(top.size() == k);
+    REQUIRE(max_error <= sketch.error_bound());
+    REQUIRE(no_of_exact_top_found == k);
+}
+
+const std::vector<std::string>& vocabulary();
+
+TEST_CASE("HeavyHitters - exact top k of a zipf dataset")
+{
+    const auto zipf_words = make_words(Distribution::zipf, 1'000'000, vocabulary());
+    auto exact = count_words(zipf_words);
+
+    constexpr size_t k = 20;
+    size_t no_of_threads = GENERATE(1u, 4u, 8u);
+    INFO("No of threads: " << no_of_threads);
+
+    std::vector<std::pair<std::string_view, size_t>> exact_top(exact.begin(), exact.end());
+    std::partial_sort(exact_top.begin(), exact_top.begin() + k, exact_top.end(), [](const auto& a, const auto& b) { return a.second > b.second; });
+    exact_top.resize(k);
+
+    auto top = heavy_hitters_parallel(zipf_words, no_of_threads, k).top();
+
+    REQUIRE(top.size() == k);
+
+    for (const auto& [word, count] : exact_top)
+    {
+        INFO("Word: " << word << ", count: " << count);
+        REQUIRE(std::any_of(top.begin(), top.end(), [word = word](const auto& t) { return t.first == word; }));
+    }
+}
+
+TEST_CASE("HeavyHitters - merged sketches estimate like one sketch of both streams")
+{
+    auto all_words = load_words_mapped("tokens.txt");
+    const auto& views = all_words.words();
+    auto middle = views.begin() + views.size() / 2;
+
+    CountMinSketch whole{1024, 3}, first_half{1024, 3}, second_half{1024, 3};
+    std::for_each(views.begin(), views.end(), [&](auto word) { whole.add(word); });
+    std::for_each(views.begin(), middle, [&](auto word) { first_half.add(word); });
+    std::for_each(middle, views.end(), [&](auto word) { second_half.add(word); });
+
+    first_half.merge(second_half);
+
+    REQUIRE(first_half.total() == whole.total());
+    REQUIRE(std::all_of(views.begin(), views.end(), [&](auto word) { return first_half.estimate(word) == whole.estimate(word); }));
+    REQUIRE_THROWS_AS(whole.merge(CountMinSketch{2048, 3}), std::invalid_argument);
+}
+
+TEST_CASE("heavy hitters")
+{
+    auto all_words = load_words_mapped("tokens.txt");
+    benchmark_results().set_dataset_size(all_words.size());
+
+    BENCHMARK("heavy hitters - exact counts - std::unordered_map")
+    {
+        return count_words(all_words);
+    };
+
+    const size_t max_no_of_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (size_t no_of_threads = 1; no_of_threads < 2 * max_no_of_threads; no_of_threads *= 2)
+    {
+        no_of_threads = std::min(no_of_threads, max_no_of_threads);
+
+        BENCHMARK("heavy hitters - count-min top 20 - threads: " + std::to_string(no_of_threads))
+        {
+            return heavy_hitters_parallel(all_words, no_of_threads, 20).top();
+        };
+    }
+}
+
+TEST_CASE("sort_case_insensitive - order of to_lower_copy comparator")
+{
+    auto to_lower_less = [](const auto& a, const auto& b) { return boost::to_lower_copy(std::string{a}) < boost::to_lower_copy(std::string{b}); };
+
+    auto sorted_words = words;
+    sort_case_insensitive(std::execution::par, sorted_words);
+    REQUIRE(std::is_sorted(sorted_words.begin(), sorted_words.end(), to_lower_less));
+    REQUIRE(std::is_permutation(sorted_words.begin(), sorted_words.end(), words.begin(), words.end()));
+
+    std::vector<std::string_view> sorted_views(words.begin(), words.end());
+    sort_case_insensitive(sorted_views);
+    REQUIRE(std::is_sorted(sorted_views.begin(), sorted_views.end(), to_lower_less));
+    REQUIRE(std::equal(sorted_views.begin(), sorted_views.end(), sorted_words.begin(), sorted_words.end(),
+        [](std::string_view a, std::string_view b) { return boost::iequals(a, b); }));
+}
+
+TEST_CASE("radix_sort - same order as std::sort")
+{
+    SECTION("case sensitive")
+    {
+        auto expected = words;
+        std::sort(expected.begin(), expected.end());
+
+        auto sorted_words = words;
+        radix_sort(sorted_words);
+        REQUIRE(sorted_words == expected);
+
+        std::vector<std::string_view> sorted_views(words.begin(), words.end());
+        radix_sort(std::execution::par, sorted_views);
+        REQUIRE(std::equal(sorted_views.begin(), sorted_views.end(), expected.begin(), expected.end()));
+    }
+
+    SECTION("case insensitive")
+    {
+        auto expected = words;
+        std::for_each(expected.begin(), expected.end(), [](auto& w) { boost::to_lower(w); });
+        std::sort(expected.begin(), expected.end());
+
+        auto sorted_words = words;
+        radix_sort(std::execution::par, sorted_words, Case::insensitive);
+        std::for_each(sorted_words.begin(), sorted_words.end(), [](auto& w) { boost::to_lower(w); });
+        REQUIRE(sorted_words == expected);
+    }
+
+    SECTION("empty words, common prefixes and non-ASCII bytes")
+    {
+        std::vector<std::string> tricky_words;
+        for (int i = 0; i < 500; ++i)
+        {
+            tricky_words.push_back(std::string(i % 7, 'a') + std::to_string(i * 7919 % 101));
+            tricky_words.push_back(std::string(200, 'x') + static_cast<char>(i % 256));
+            tricky_words.push_back("");
+        }
+
+        auto expected = tricky_words;
+        std::sort(expected.begin(), expected.end());
+
+        radix_sort(std::execution::par, tricky_words);
+        REQUIRE(tricky_words == expected);
+    }
+}
+
+TEST_CASE("AllocationTracker - allocation free paths stay allocation free")
+{
+    auto words_to_sort = words;
+    std::vector<std::string_view> words_views(words.begin(), words.end());
+
+    auto case_insensitive_less = [](std::string_view a, std::string_view b) {
+        return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(), [](unsigned char x, unsigned char y) { return std::tolower(x) < std::tolower(y); });
+    };
+
+    auto to_lower_copy_less = [](const auto& a, const auto& b) { return boost::to_lower_copy(a) < boost::to_lower_copy(b); };
+
+    auto counted = count_allocations([&] { std::sort(words_to_sort.begin(), words_to_sort.end(), case_insensitive_less); });
+    REQUIRE(counted.count == 0);
+
+    size_t hash_total = 0;
+    counted = count_allocations([&] { hash_total = std::accumulate(words_views.begin(), words_views.end(), size_t{0}, [](size_t total, auto word) { return total + WyHash{}(word); }); });
+    REQUIRE(counted.count == 0);
+    REQUIRE(hash_total != 0);
+
+    counted = count_allocations([&] { to_lower_ascii(words_to_sort.front()); });
+    REQUIRE(counted.count == 0);
+
+    // two strings per comparison - the long ones do not fit into the small string buffer
+    std::vector<std::string> long_words(1000);
+    std::generate(long_words.begin(), long_words.end(), [i = 0]() mutable { return "Long enough not to fit into SSO - " + std::to_string(i++ * 7919 % 1000); });
+
+    counted = count_allocations([&] { std::sort(long_words.begin(), long_words.end(), to_lower_copy_less); });
+    std::cout << "std::sort with to_lower_copy comparator - " << long_words.size() << " words: " << counted.count << " allocations, "
+              << counted.bytes << " bytes, peak live: " << counted.peak_live_bytes << " bytes\n";
+    REQUIRE(counted.count >= 2 * long_words.size());
+
+    std::unique_ptr<std::array<char, 1000>> block;
+    counted = count_allocations([&] { block = std::make_unique<std::array<char, 1000>>(); });
+    REQUIRE(counted.count == 1);
+    REQUIRE(counted.bytes == 1000);
+#ifdef ALLOCATION_TRACKER_HAS_USABLE_SIZE
+    REQUIRE(counted.peak_live_bytes >= 1000);
+
+    // a block allocated before start() and freed while counting does not lower the peak
+    auto allocated_before = std::make_unique<std::array<char, 4096>>();
+    counted = count_allocations([&] {
+        allocated_before.reset();
+        block = std::make_unique<std::array<char, 1000>>();
+    });
+    REQUIRE(counted.peak_live_bytes >= 1000);
+#endif
+
+    // more short lived threads than slots - slots of finished threads are reused, no counts are lost
+    auto spawn_threads = [](size_t no_of_threads) {
+        for (size_t i = 0; i < no_of_threads; i += 4)
+        {
+            std::array<std::unique_ptr<std::array<char, 100>>, 4> blocks; // kept, so the allocations are not elided
+            std::array<std::thread, 4> batch;
+            for (size_t j = 0; j < batch.size(); ++j)
+                batch[j] = std::thread{[&block = blocks[j]] { block = std::make_unique<std::array<char, 100>>(); }};
+            for (auto& t : batch)
+                t.join();
+        }
+    };
+
+    const auto per_batch = count_allocations([&] { spawn_threads(4); }).count;
+    REQUIRE(per_batch >= 8); // a thread state and a block per thread
+    REQUIRE(count_allocations([&] { spawn_threads(600); }).count == 150 * per_batch);
+}
+
+// the input is copied for every run outside of the measurement, so every run gets the same distribution
+// (an algorithm working in place would otherwise see its own output from the second run on)
+template <typename Data, typename Algorithm>
+void benchmark_on_copies(const std::string& name, const Data& data, Algorithm algorithm)
+{
+    BENCHMARK_ADVANCED(name.c_str())(Catch::Benchmark::Chronometer meter)
+    {
+        std::vector<Data> inputs(meter.runs(), data);
+        meter.measure([&](int run) { return algorithm(inputs[run]); });
+    };
+}
+
+TEST_CASE("sort")
+{
+    benchmark_results().set_dataset_size(words.size());
+
+    SECTION("sequenced")
+    {
+        REQUIRE_FALSE(std::is_sorted(words.begin(), words.end()));
+
+        benchmark_on_copies("std::sort", words, [](auto& words_to_sort) {
+            std::sort(words_to_sort.begin(), words_to_sort.end(), [](const auto& a, const auto& b) { return boost::to_lower_copy(a) < boost::to_lower_copy(b); });
+            return words_to_sort.front();
+        });
+    }
+
+    SECTION("parallel")
+    {
+        REQUIRE_FALSE(std::is_sorted(words.begin(), words.end()));
+
+        benchmark_on_copies("std::sort - parallel", words, [](auto& words_to_sort) {
+            std::sort(
+                std::execution::par,
+                words_to_sort.begin(), words_to_sort.end(),
+                [](const auto& a, const auto& b) { return boost::to_lower_copy(a) < boost::to_lower_copy(b); });
+
+            return words_to_sort.front();
+        });
+    }
+
+    SECTION("work-stealing pool")
+    {
+        REQUIRE_FALSE(std::is_sorted(words.begin(), words.end()));
+
+        benchmark_on_copies("parallel_sort - work-stealing pool", words, [](auto& words_to_sort) {
+            parallel_sort(
+                benchmark_pool(),
+                words_to_sort.begin(), words_to_sort.end(),
+                [](const auto& a, const auto& b) { return boost::to_lower_copy(a) < boost::to_lower_copy(b); });
+
+            return words_to_sort.front();
+        });
+    }
+
+    SECTION("parallel unsequenced")
+    {
+        REQUIRE_FALSE(std::is_sorted(words.begin(), words.end()));
+
+        benchmark_on_copies("std::sort - parallel unseqenced", words, [](auto& words_to_sort) {
+            std::for_each(std::execution::par, words_to_sort.begin(), words_to_sort.end(), [](auto& w) { boost::to_lower(w); });
+            std::vector<std::string_view> words_views(words_to_sort.size());
+            std::transform(std::execution::par, words_to_sort.begin(), words_to_sort.end(), words_views.begin(), [](const auto& w) { return std::string_view(w); });
+
+            std::sort(
+                std::execution::par_unseq,
+                words_views.begin(), words_views.end());
+
+            return std::string(words_views.front());
+        });
+    }
+
+    SECTION("parallel unsequenced - to_lower_ascii")
+    {
+        REQUIRE_FALSE(std::is_sorted(words.begin(), words.end()));
+
+        benchmark_on_copies("std::sort - parallel unseqenced - to_lower_ascii", words, [](auto& words_to_sort) {
+            std::for_each(std::execution::par, words_to_sort.begin(), words_to_sort.end(), [](auto& w) { to_lower_ascii(w); });
+            std::vector<std::string_view> words_views(words_to_sort.size());
+            std::transform(std::execution::par, words_to_sort.begin(), words_to_sort.end(), words_views.begin(), [](const auto& w) { return std::string_view(w); });
+
+            std::sort(
+                std::execution::par_unseq,
+                words_views.begin(), words_views.end());
+
+            return std::string(words_views.front());
+        });
+    }
+
+    SECTION("collation keys - sequenced")
+    {
+        REQUIRE_FALSE(std::is_sorted(words.begin(), words.end()));
+
+        benchmark_on_copies("sort_case_insensitive - collation keys", words, [](auto& words_to_sort) {
+            sort_case_insensitive(words_to_sort);
+            return words_to_sort.front();
+        });
+    }
+
+    SECTION("collation keys - parallel")
+    {
+        REQUIRE_FALSE(std::is_sorted(words.begin(), words.end()));
+
+        benchmark_on_copies("sort_case_insensitive - collation keys - parallel", words, [](auto& words_to_sort) {
+            sort_case_insensitive(std::execution::par, words_to_sort);
+            return words_to_sort.front();
+        });
+    }
+
+    SECTION("radix sort - sequenced")
+    {
+        REQUIRE_FALSE(std::is_sorted(words.begin(), words.end()));
+
+        benchmark_on_copies("radix_sort - case insensitive", words, [](auto& words_to_sort) {
+            radix_sort(words_to_sort, Case::insensitive);
+            return words_to_sort.front();
+        });
+    }
+
+    SECTION("radix sort - parallel")
+    {
+        REQUIRE_FALSE(std::is_sorted(words.begin(), words.end()));
+
+        benchmark_on_copies("radix_sort - case insensitive - parallel", words, [](auto& words_to_sort) {
+            radix_sort(std::execution::par, words_to_sort, Case::insensitive);
+            return words_to_sort.front();
+        });
+    }
+
+    SECTION("radix sort - parallel - std::string_view")
+    {
+        const std::vector<std::string_view> words_views(words.begin(), words.end());
+
+        benchmark_on_copies("radix_sort - case insensitive - parallel - std::string_view", words_views, [](auto& views_to_sort) {
+            radix_sort(std::execution::par, views_to_sort, Case::insensitive);
+            return std::string(views_to_sort.front());
+        });
+    }
+}
+
+TEST_CASE("sort - words layout")
+{
+    benchmark_results().set_dataset_size(words.size());
+
+    // allocation free, so the comparison cost does not hide the memory layout
+    auto case_insensitive_less = [](std::string_view a, std::string_view b) {
+        return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(), [](unsigned char x, unsigned char y) { return std::tolower(x) < std::tolower(y); });
+    };
+
+    SECTION("std::vector<std::string>")
+    {
+        benchmark_on_copies("std::sort - std::vector<std::string>", words, [&](auto& words_to_sort) {
+            std::sort(words_to_sort.begin(), words_to_sort.end(), case_insensitive_less);
+            return words_to_sort.front();
+        });
+
+        benchmark_on_copies("std::sort - parallel - std::vector<std::string>", words, [&](auto& words_to_sort) {
+            std::sort(std::execution::par, words_to_sort.begin(), words_to_sort.end(), case_insensitive_less);
+            return words_to_sort.front();
+        });
+    }
+
+    SECTION("TokenTable")
+    {
+        benchmark_on_copies("std::sort - TokenTable", words_table, [&](auto& words_to_sort) {
+            words_to_sort.sort(case_insensitive_less);
+            return words_to_sort[0];
+        });
+
+        benchmark_on_copies("std::sort - parallel - TokenTable", words_table, [&](auto& words_to_sort) {
+            words_to_sort.sort(std::execution::par, case_insensitive_less);
+            return words_to_sort[0];
+        });
+    }
+}
+
+bool is_prime(uint64_t number)
+{
+    if (number < 2)
+    {
+        return false;
+    }
+    else if (number % 2 == 0 && number != 2)
+    {
+        return false;
+    }
+    else
+    {
+        for (uint64_t i = 3; i <= sqrt(number); i += 2)
+        {
+            if (number % i == 0)
+                return false;
+        }
+        return true;
+    }
+}
+
+const size_t no_of_items = 20'000;
+
+// dataset scale 0.1 gives no_of_items numbers
+std::vector<uint64_t> scaled_numbers(double scale, uint64_t max_value)
+{
+    return make_numbers(Distribution::uniform, static_cast<size_t>(no_of_items * scale / BenchmarkSweep::default_dataset_scale), max_value);
+}
+
+std::vector<uint64_t> numbers = scaled_numbers(BenchmarkSweep::default_dataset_scale, no_of_items);
+
+TEST_CASE("PrimeSieve - same answers as is_prime")
+{
+    PrimeSieve sieve{100'000};
+
+    for (uint64_t n = 0; n <= 100'000; ++n)
+    {
+        if (sieve.test(n) != is_prime(n))
+            FAIL("n = " << n);
+    }
+
+    SECTION("grows lazily")
+    {
+        PrimeSieve lazy_sieve{10};
+        REQUIRE(lazy_sieve.limit() == 10);
+
+        REQUIRE(lazy_sieve.is_prime(1'000'003));
+        REQUIRE_FALSE(lazy_sieve.is_prime(1'000'001));
+        REQUIRE(lazy_sieve.limit() >= 1'000'003);
+
+        for (uint64_t n = 999'000; n <= 1'000'003; ++n)
+            REQUIRE(lazy_sieve.test(n) == is_prime(n));
+    }
+}
+
+TEST_CASE("is_prime_u64 - same answers as is_prime")
+{
+    for (uint64_t n = 0; n <= 200'000; ++n)
+    {
+        if (is_prime_u64(n) != is_prime(n))
+            FAIL("n = " << n);
+    }
+
+    for (uint64_t start : {(1ULL << 32) - 1'000, 4'759'123'141ULL - 1'000})
+    {
+        for (uint64_t n = start; n <= start + 2'000; ++n)
+        {
+            if (is_prime_u64(n) != is_prime(n))
+                FAIL("n = " << n);
+        }
+    }
+
+    REQUIRE(is_prime_u64((1ULL << 61) - 1));           // Mersenne prime
+    REQUIRE(is_prime_u64(18'446'744'073'709'551'557ULL)); // largest 64-bit prime
+    REQUIRE_FALSE(is_prime_u64(3'215'031'751ULL));       // strong pseudoprime to bases 2, 3, 5 and 7
+    REQUIRE_FALSE(is_prime_u64(3'825'123'056'546'413'051ULL)); // strong pseudoprime to bases 2..23
+    REQUIRE_FALSE(is_prime_u64(18'446'744'073'709'551'615ULL));
+}
+
+TEST_CASE("PrimeSieve - build")
+{
+    benchmark_results().set_dataset_size(no_of_items);
+
+    BENCHMARK("PrimeSieve - build for no_of_items")
+    {
+        return PrimeSieve{no_of_items}.limit();
+    };
+
+    BENCHMARK("PrimeSieve - build for 10'000'000")
+    {
+        return PrimeSieve{10'000'000}.limit();
+    };
+}
+
+std::vector<uint64_t> numbers_u64 = scaled_numbers(BenchmarkSweep::default_dataset_scale, UINT64_MAX);
+
+inline const bool numbers_registered = BenchmarkSweep::register_dataset([](double scale) {
+    numbers = scaled_numbers(scale, no_of_items);
+    numbers_u64 = scaled_numbers(scale, UINT64_MAX);
+});
+
+TEST_CASE("WorkStealingPool - algorithms")
+{
+    size_t no_of_threads = GENERATE(1u, 4u);
+    WorkStealingPool pool{no_of_threads};
+    INFO("No of threads: " << no_of_threads);
+
+    SECTION("parallel_for")
+    {
+        std::vector<int> visits(100'000);
+        parallel_for(pool, size_t{0}, visits.size(), [&](size_t i) { ++visits[i]; });
+        REQUIRE(std::all_of(visits.begin(), visits.end(), [](int v) { return v == 1; }));
+    }
+
+    SECTION("parallel_transform_reduce")
+    {
+        auto hash = [](const auto& word) { return std::hash<std::string>{}(word); };
+        auto expected = std::accumulate(words.begin(), words.end(), 7ULL, [&](auto total, const auto& word) { return total + hash(word); });
+        REQUIRE(parallel_transform_reduce(pool, words.begin(), words.end(), 7ULL, std::plus{}, hash) == expected);
+        REQUIRE(parallel_transform_reduce(pool, words.begin(), words.begin(), 7ULL, std::plus{}, hash) == 7ULL);
+    }
+
+    SECTION("parallel_sort")
+    {
+        auto expected = words;
+        std::sort(expected.begin(), expected.end());
+
+        auto sorted_words = words;
+        parallel_sort(pool, sorted_words.begin(), sorted_words.end(), std::less<>{}, 64);
+        REQUIRE(sorted_words == expected);
+
+        for (ptrdiff_t grain : {1, 2, 3}) // merges of single elements
+        {
+            std::vector<int> small{5, 3, 8, 1, 9, 2, 7, 3, 6};
+            parallel_sort(pool, small.begin(), small.end(), std::less<>{}, grain);
+
+            INFO("Grain: " << grain);
+            REQUIRE(small == std::vector<int>{1, 2, 3, 3, 5, 6, 7, 8, 9});
+        }
+    }
+
+    SECTION("parallel_partition")
+    {
+        auto numbers_to_part = numbers;
+        auto boundary = parallel_partition(pool, numbers_to_part.begin(), numbers_to_part.end(), [](auto n) { return is_prime(n); });
+
+        REQUIRE(boundary - numbers_to_part.begin() == std::count_if(numbers.begin(), numbers.end(), [](auto n) { return is_prime(n); }));
+        REQUIRE(std::is_partitioned(numbers_to_part.begin(), numbers_to_part.end(), [](auto n) { return is_prime(n); }));
+        REQUIRE(std::is_permutation(numbers_to_part.begin(), numbers_to_part.end(), numbers.begin()));
+    }
+
+    SECTION("exceptions are passed to the caller")
+    {
+        REQUIRE_THROWS_AS(parallel_for(pool, 0, 1000, [](int i) { if (i == 777) throw std::runtime_error("error"); }, 10), std::runtime_error);
+        REQUIRE(parallel_transform_reduce(pool, words.begin(), words.end(), size_t{0}, std::plus{}, [](const auto& w) { return w.size(); }) > 0);
+    }
+}
+
+TEST_CASE("transform")
+{
+    benchmark_results().set_dataset_size(numbers.size());
+
+    SECTION("sequenced")
+    {
+        auto numbers_to_part = numbers;
+        decltype(numbers_to_part) are_primes(numbers_to_part.size());
+
+        BENCHMARK("transform - sequenced")
+        {
+            std::transform(numbers_to_part.begin(), numbers_to_part.end(), are_primes.begin(), [](auto n) { return is_prime(n); });
+            return are_primes;
+        };
+    }
+
+    SECTION("parallel")
+    {
+        auto numbers_to_part = numbers;
+        decltype(numbers_to_part) are_primes(numbers_to_part.size());
+
+
+        BENCHMARK("transform - parallel")
+        {
+            std::transform(std::execution::par_unseq, numbers_to_part.begin(), numbers_to_part.end(), are_primes.begin(), [](auto n) { return is_prime(n); });
+            return are_primes;
+        };
+    }
+
+    SECTION("work-stealing pool")
+    {
+        auto numbers_to_part = numbers;
+        decltype(numbers_to_part) are_primes(numbers_to_part.size());
+
+        BENCHMARK("transform - work-stealing pool")
+        {
+            parallel_for(benchmark_pool(), size_t{0}, numbers_to_part.size(), [&](size_t i) { are_primes[i] = is_prime(numbers_to_part[i]); });
+            return are_primes;
+        };
+    }
+
+    SECTION("sieve - sequenced")
+    {
+        auto numbers_to_part = numbers;
+        decltype(numbers_to_part) are_primes(numbers_to_part.size());
+        const PrimeSieve sieve{no_of_items};
+
+        BENCHMARK("transform - sieve - sequenced")
+        {
+            std::transform(numbers_to_part.begin(), numbers_to_part.end(), are_primes.begin(), [&sieve](auto n) { return sieve.test(n); });
+            return are_primes;
+        };
+    }
+
+    SECTION("sieve - parallel")
+    {
+        auto numbers_to_part = numbers;
+        decltype(numbers_to_part) are_primes(numbers_to_part.size());
+        const PrimeSieve sieve{no_of_items};
+
+        BENCHMARK("transform - sieve - parallel")
+        {
+            std::transform(std::execution::par_unseq, numbers_to_part.begin(), numbers_to_part.end(), are_primes.begin(), [&sieve](auto n) { return sieve.test(n); });
+            return are_primes;
+        };
+    }
+
+    SECTION("miller-rabin - sequenced")
+    {
+        auto numbers_to_part = numbers;
+        decltype(numbers_to_part) are_primes(numbers_to_part.size());
+
+        BENCHMARK("transform - miller-rabin - sequenced")
+        {
+            std::transform(numbers_to_part.begin(), numbers_to_part.end(), are_primes.begin(), [](auto n) { return is_prime_u64(n); });
+            return are_primes;
+        };
+
+        numbers_to_part = numbers_u64;
+
+        BENCHMARK("transform - miller-rabin - sequenced - 64-bit range")
+        {
+            std::transform(numbers_to_part.begin(), numbers_to_part.end(), are_primes.begin(), [](auto n) { return is_prime_u64(n); });
+            return are_primes;
+        };
+    }
+
+    SECTION("miller-rabin - parallel")
+    {
+        auto numbers_to_part = numbers;
+        decltype(numbers_to_part) are_primes(numbers_to_part.size());
+
+        BENCHMARK("transform - miller-rabin - parallel")
+        {
+            std::transform(std::execution::par_unseq, numbers_to_part.begin(), numbers_to_part.end(), are_primes.begin(), [](auto n) { return is_prime_u64(n); });
+            return are_primes;
+        };
+
+        numbers_to_part = numbers_u64;
+
+        BENCHMARK("transform - miller-rabin - parallel - 64-bit range")
+        {
+            std::transform(std::execution::par_unseq, numbers_to_part.begin(), numbers_to_part.end(), are_primes.begin(), [](auto n) { return is_prime_u64(n); });
+            return are_primes;
+        };
+    }
+}
+
+TEST_CASE("parallel_stable_partition - same order as std::stable_partition")
+{
+    auto is_prime_number = [](auto n) { return is_prime(n); };
+    auto expected = numbers;
+    auto expected_boundary = std::stable_partition(expected.begin(), expected.end(), is_prime_number) - expected.begin();
+
+    SECTION("copy")
+    {
+        std::vector<uint64_t> partitioned(numbers.size());
+        auto boundary = parallel_stable_partition_copy(std::execution::par, numbers.begin(), numbers.end(), partitioned.begin(), is_prime_number);
+
+        REQUIRE(boundary - partitioned.begin() == expected_boundary);
+        REQUIRE(partitioned == expected);
+    }
+
+    SECTION("in place with bounded scratch")
+    {
+        size_t scratch_size = GENERATE(size_t{1}, size_t{1000}, size_t{1} << 16);
+        INFO("Scratch size: " << scratch_size);
+
+        auto partitioned = numbers;
+        auto boundary = parallel_stable_partition(std::execution::par, partitioned.begin(), partitioned.end(), is_prime_number, scratch_size);
+
+        REQUIRE(boundary - partitioned.begin() == expected_boundary);
+        REQUIRE(partitioned == expected);
+    }
+
+    SECTION("words are moved, not lost")
+    {
+        auto is_short = [](const std::string& w) { return w.size() < 5; };
+        auto expected_words = words;
+        std::stable_partition(expected_words.begin(), expected_words.end(), is_short);
+
+        auto partitioned = words;
+        parallel_stable_partition(std::execution::par, partitioned.begin(), partitioned.end(), is_short, 777);
+        REQUIRE(partitioned == expected_words);
+    }
+
+    SECTION("empty range")
+    {
+        std::vector<uint64_t> empty;
+        REQUIRE(parallel_stable_partition(std::execution::seq, empty.begin(), empty.end(), is_prime_number) == empty.end());
+    }
+}
+
+TEST_CASE("partition")
+{
+    benchmark_results().set_dataset_size(numbers.size());
+
+    SECTION("sequenced")
+    {
+        auto numbers_to_part = numbers;
+
+        BENCHMARK("partition - sequenced")
+        {
+            return std::partition(numbers_to_part.begin(), numbers_to_part.end(), [](auto n) { return is_prime(n); });
+        };
+    }
+
+    SECTION("parallel")
+    {
+        auto numbers_to_part = numbers;
+
+        BENCHMARK("partition - parallel")
+        {
+            return std::partition(std::execution::par_unseq, numbers_to_part.begin(), numbers_to_part.end(), [](auto n) { return is_prime(n); });
+        };
+    }
+
+    SECTION("work-stealing pool")
+    {
+        auto numbers_to_part = numbers;
+
+        BENCHMARK("partition - work-stealing pool")
+        {
+            return parallel_partition(benchmark_pool(), numbers_to_part.begin(), numbers_to_part.end(), [](auto n) { return is_prime(n); });
+        };
+    }
+
+    SECTION("sieve - sequenced")
+    {
+        auto numbers_to_part = numbers;
+        const PrimeSieve sieve{no_of_items};
+
+        BENCHMARK("partition - sieve - sequenced")
+        {
+            return std::partition(numbers_to_part.begin(), numbers_to_part.end(), [&sieve](auto n) { return sieve.test(n); });
+        };
+    }
+
+    SECTION("sieve - parallel")
+    {
+        auto numbers_to_part = numbers;
+        const PrimeSieve sieve{no_of_items};
+
+        BENCHMARK("partition - sieve - parallel")
+        {
+            return std::partition(std::execution::par_unseq, numbers_to_part.begin(), numbers_to_part.end(), [&sieve](auto n) { return sieve.test(n); });
+        };
+    }
+
+    SECTION("stable - sequenced")
+    {
+        auto numbers_to_part = numbers;
+
+        BENCHMARK("stable partition - std::stable_partition - sequenced")
+        {
+            return std::stable_partition(numbers_to_part.begin(), numbers_to_part.end(), [](auto n) { return is_prime(n); });
+        };
+    }
+
+    SECTION("stable - parallel")
+    {
+        auto numbers_to_part = numbers;
+
+        BENCHMARK("stable partition - std::stable_partition - parallel")
+        {
+            return std::stable_partition(std::execution::par, numbers_to_part.begin(), numbers_to_part.end(), [](auto n) { return is_prime(n); });
+        };
+    }
+
+    SECTION("stable - scatter copy - parallel")
+    {
+        auto numbers_to_part = numbers;
+        decltype(numbers_to_part) partitioned(numbers_to_part.size());
+
+        BENCHMARK("stable partition - scatter copy - parallel")
+        {
+            return parallel_stable_partition_copy(std::execution::par, numbers_to_part.begin(), numbers_to_part.end(), partitioned.begin(), [](auto n) { return is_prime(n); });
+        };
+    }
+
+    SECTION("stable - in place with bounded scratch - parallel")
+    {
+        auto numbers_to_part = numbers;
+
+        BENCHMARK("stable partition - in place with bounded scratch - parallel")
+        {
+            return parallel_stable_partition(std::execution::par, numbers_to_part.begin(), numbers_to_part.end(), [](auto n) { return is_prime(n); }, 4096);
+        };
+    }
+}
+
+TEST_CASE("parallel_classify_partition_copy - same flags and order as transform + stable_partition")
+{
+    auto is_prime_number = [](auto n) { return is_prime(n); };
+
+    std::vector<uint64_t> expected_flags(numbers.size());
+    std::transform(numbers.begin(), numbers.end(), expected_flags.begin(), is_prime_number);
+    auto expected = numbers;
+    auto expected_boundary = std::stable_partition(expected.begin(), expected.end(), is_prime_number) - expected.begin();
+
+    std::vector<uint64_t> are_primes(numbers.size());
+    std::vector<uint64_t> partitioned(numbers.size());
+    size_t no_of_calls = 0;
+
+    auto boundary = parallel_classify_partition_copy(std::execution::seq, numbers.begin(), numbers.end(), are_primes.begin(), partitioned.begin(),
+        [&](auto n) { ++no_of_calls; return is_prime(n); });
+
+    REQUIRE(no_of_calls == numbers.size()); // once per element
+    REQUIRE(are_primes == expected_flags);
+    REQUIRE(partitioned == expected);
+    REQUIRE(boundary - partitioned.begin() == expected_boundary);
+
+    std::fill(are_primes.begin(), are_primes.end(), 0);
+    parallel_classify_partition_copy(std::execution::par, numbers.begin(), numbers.end(), are_primes.begin(), partitioned.begin(), is_prime_number);
+    REQUIRE(are_primes == expected_flags);
+    REQUIRE(partitioned == expected);
+}
+
+TEST_CASE("classify and partition")
+{
+    benchmark_results().set_dataset_size(numbers.size());
+
+    std::vector<uint64_t> are_primes(numbers.size());
+
+    SECTION("transform + partition - sequenced")
+    {
+        auto numbers_to_part = numbers;
+
+        BENCHMARK("classify and partition - transform + partition - sequenced")
+        {
+            std::transform(numbers_to_part.begin(), numbers_to_part.end(), are_primes.begin(), [](auto n) { return is_prime(n); });
+            return std::partition(numbers_to_part.begin(), numbers_to_part.end(), [](auto n) { return is_prime(n); });
+        };
+    }
+
+    SECTION("transform + partition - parallel")
+    {
+        auto numbers_to_part = numbers;
+
+        BENCHMARK("classify and partition - transform + partition - parallel")
         {
+            std::transform(std::execution::par_unseq, numbers_to_part.begin(), numbers_to_part.end(), are_primes.begin(), [](auto n) { return is_prime(n); });
             return std::partition(std::execution::par_unseq, numbers_to_part.begin(), numbers_to_part.end(), [](auto n) { return is_prime(n); });
         };
     }
+
+    SECTION("fused - sequenced")
+    {
+        std::vector<uint64_t> partitioned(numbers.size());
+
+        BENCHMARK("classify and partition - fused - sequenced")
+        {
+            return parallel_classify_partition_copy(std::execution::seq, numbers.begin(), numbers.end(), are_primes.begin(), partitioned.begin(), [](auto n) { return is_prime(n); });
+        };
+    }
+
+    SECTION("fused - parallel")
+    {
+        std::vector<uint64_t> partitioned(numbers.size());
+
+        BENCHMARK("classify and partition - fused - parallel")
+        {
+            return parallel_classify_partition_copy(std::execution::par, numbers.begin(), numbers.end(), are_primes.begin(), partitioned.begin(), [](auto n) { return is_prime(n); });
+        };
+    }
+}
+
+TEST_CASE("blocked scans - same results as the std scans")
+{
+    // sizes around the block boundaries
+    size_t size = GENERATE(size_t{0}, size_t{1}, size_t{16 * 1024}, size_t{16 * 1024 + 1}, size_t{100'000});
+    INFO("Size: " << size);
+
+    std::vector<uint64_t> input(numbers.begin(), numbers.begin() + std::min(size, numbers.size()));
+    while (input.size() < size)
+        input.push_back(input.size() * 7919 % 1000);
+
+    std::vector<uint64_t> expected(size), result(size);
+
+    std::inclusive_scan(input.begin(), input.end(), expected.begin());
+    REQUIRE(blocked_inclusive_scan(std::execution::par, input.begin(), input.end(), result.begin()) == result.end());
+    REQUIRE(result == expected);
+
+    std::exclusive_scan(input.begin(), input.end(), expected.begin(), uint64_t{42});
+    blocked_exclusive_scan(std::execution::par, input.begin(), input.end(), result.begin(), uint64_t{42});
+    REQUIRE(result == expected);
+
+    auto in_place = input;
+    blocked_exclusive_scan(std::execution::par, in_place.begin(), in_place.end(), in_place.begin(), uint64_t{42});
+    REQUIRE(in_place == expected);
+
+    std::vector<std::string> text(size, "abc");
+    std::vector<size_t> expected_lengths(size), lengths(size);
+    auto length = [](const std::string& w) { return w.size(); };
+    std::transform_inclusive_scan(text.begin(), text.end(), expected_lengths.begin(), std::plus{}, length);
+    blocked_transform_inclusive_scan(std::execution::par, text.begin(), text.end(), lengths.begin(), std::plus{}, length);
+    REQUIRE(lengths == expected_lengths);
+}
+
+TEST_CASE("scan")
+{
+    SECTION("numbers")
+    {
+        benchmark_results().set_dataset_size(numbers.size());
+        std::vector<uint64_t> sums(numbers.size());
+
+        BENCHMARK("inclusive_scan - numbers - sequenced")
+        {
+            return std::inclusive_scan(std::execution::seq, numbers.begin(), numbers.end(), sums.begin());
+        };
+
+        BENCHMARK("inclusive_scan - numbers - parallel")
+        {
+            return std::inclusive_scan(std::execution::par, numbers.begin(), numbers.end(), sums.begin());
+        };
+
+        BENCHMARK("inclusive_scan - numbers - parallel unsequenced")
+        {
+            return std::inclusive_scan(std::execution::par_unseq, numbers.begin(), numbers.end(), sums.begin());
+        };
+
+        BENCHMARK("inclusive_scan - numbers - blocked two-pass - parallel")
+        {
+            return blocked_inclusive_scan(std::execution::par, numbers.begin(), numbers.end(), sums.begin());
+        };
+
+        BENCHMARK("exclusive_scan - numbers - sequenced")
+        {
+            return std::exclusive_scan(std::execution::seq, numbers.begin(), numbers.end(), sums.begin(), uint64_t{0});
+        };
+
+        BENCHMARK("exclusive_scan - numbers - parallel")
+        {
+            return std::exclusive_scan(std::execution::par, numbers.begin(), numbers.end(), sums.begin(), uint64_t{0});
+        };
+
+        BENCHMARK("exclusive_scan - numbers - parallel unsequenced")
+        {
+            return std::exclusive_scan(std::execution::par_unseq, numbers.begin(), numbers.end(), sums.begin(), uint64_t{0});
+        };
+
+        BENCHMARK("exclusive_scan - numbers - blocked two-pass - parallel")
+        {
+            return blocked_exclusive_scan(std::execution::par, numbers.begin(), numbers.end(), sums.begin(), uint64_t{0});
+        };
+    }
+
+    SECTION("word lengths")
+    {
+        benchmark_results().set_dataset_size(words.size());
+        std::vector<size_t> offsets(words.size());
+        auto length = [](const std::string& word) { return word.size(); };
+
+        BENCHMARK("transform_inclusive_scan - word lengths - sequenced")
+        {
+            return std::transform_inclusive_scan(std::execution::seq, words.begin(), words.end(), offsets.begin(), std::plus{}, length);
+        };
+
+        BENCHMARK("transform_inclusive_scan - word lengths - parallel")
+        {
+            return std::transform_inclusive_scan(std::execution::par, words.begin(), words.end(), offsets.begin(), std::plus{}, length);
+        };
+
+        BENCHMARK("transform_inclusive_scan - word lengths - parallel unsequenced")
+        {
+            return std::transform_inclusive_scan(std::execution::par_unseq, words.begin(), words.end(), offsets.begin(), std::plus{}, length);
+        };
+
+        BENCHMARK("transform_inclusive_scan - word lengths - blocked two-pass - parallel")
+        {
+            return blocked_transform_inclusive_scan(std::execution::par, words.begin(), words.end(), offsets.begin(), std::plus{}, length);
+        };
+
+        std::vector<size_t> lengths(words.size());
+        std::transform(words.begin(), words.end(), lengths.begin(), length);
+
+        BENCHMARK("exclusive_scan - word lengths - sequenced")
+        {
+            return std::exclusive_scan(std::execution::seq, lengths.begin(), lengths.end(), offsets.begin(), size_t{0});
+        };
+
+        BENCHMARK("exclusive_scan - word lengths - parallel")
+        {
+            return std::exclusive_scan(std::execution::par, lengths.begin(), lengths.end(), offsets.begin(), size_t{0});
+        };
+
+        BENCHMARK("exclusive_scan - word lengths - parallel unsequenced")
+        {
+            return std::exclusive_scan(std::execution::par_unseq, lengths.begin(), lengths.end(), offsets.begin(), size_t{0});
+        };
+
+        BENCHMARK("exclusive_scan - word lengths - blocked two-pass - parallel")
+        {
+            return blocked_exclusive_scan(std::execution::par, lengths.begin(), lengths.end(), offsets.begin(), size_t{0});
+        };
+    }
+}
+
+// distinct words of the corpus in order of their first occurrence
+const std::vector<std::string>& vocabulary()
+{
+    static const std::vector<std::string> vocabulary = [] {
+        std::vector<std::string> vocabulary;
+        std::unordered_set<std::string_view> seen;
+        auto all_words = load_words_mapped("tokens.txt");
+
+        for (auto word : all_words)
+        {
+            if (seen.insert(word).second)
+                vocabulary.emplace_back(word);
+        }
+
+        return vocabulary;
+    }();
+
+    return vocabulary;
+}
+
+TEST_CASE("datasets - seeded and shaped by the distribution")
+{
+    Distribution distribution = GENERATE(from_range(all_distributions));
+    INFO("Distribution: " << to_string(distribution));
+
+    auto numbers_a = make_numbers(distribution, 10'000, no_of_items, 42);
+    auto words_a = make_words(distribution, 10'000, vocabulary(), 42);
+
+    REQUIRE(numbers_a == make_numbers(distribution, 10'000, no_of_items, 42));
+    REQUIRE(words_a == make_words(distribution, 10'000, vocabulary(), 42));
+    REQUIRE(numbers_a != make_numbers(distribution, 10'000, no_of_items, 43));
+    REQUIRE(std::all_of(numbers_a.begin(), numbers_a.end(), [](auto n) { return n <= no_of_items; }));
+
+    std::unordered_set<uint64_t> distinct_numbers(numbers_a.begin(), numbers_a.end());
+    std::unordered_set<std::string> distinct_words(words_a.begin(), words_a.end());
+
+    switch (distribution)
+    {
+    case Distribution::sorted:
+        REQUIRE(std::is_sorted(numbers_a.begin(), numbers_a.end()));
+        REQUIRE(std::is_sorted(words_a.begin(), words_a.end()));
+        break;
+    case Distribution::reverse_sorted:
+        REQUIRE(std::is_sorted(numbers_a.rbegin(), numbers_a.rend()));
+        REQUIRE(std::is_sorted(words_a.rbegin(), words_a.rend()));
+        break;
+    case Distribution::few_unique:
+        REQUIRE(distinct_numbers.size() <= 16);
+        REQUIRE(distinct_words.size() <= 16);
+        break;
+    case Distribution::zipf:
+        REQUIRE(std::count(numbers_a.begin(), numbers_a.end(), 0) > 500); // rank 0 - about 1 / H(n) of the draws
+        REQUIRE(std::count(words_a.begin(), words_a.end(), vocabulary().front()) > 500);
+        break;
+    case Distribution::uniform:
+        REQUIRE(distinct_numbers.size() > 5'000);
+        break;
+    }
+
+    REQUIRE(make_numbers(Distribution::zipf, 1000, UINT64_MAX).size() == 1000);
+}
+
+TEST_CASE("transform - datasets")
+{
+    Distribution distribution = GENERATE(from_range(all_distributions));
+    auto dataset = make_numbers(distribution, numbers.size(), no_of_items);
+    benchmark_results().set_dataset_size(dataset.size());
+
+    std::vector<uint64_t> are_primes(dataset.size());
+
+    BENCHMARK(std::string{"transform - sequenced - "} + to_string(distribution))
+    {
+        std::transform(dataset.begin(), dataset.end(), are_primes.begin(), [](auto n) { return is_prime(n); });
+        return are_primes;
+    };
+
+    BENCHMARK(std::string{"transform - parallel - "} + to_string(distribution))
+    {
+        std::transform(std::execution::par_unseq, dataset.begin(), dataset.end(), are_primes.begin(), [](auto n) { return is_prime(n); });
+        return are_primes;
+    };
+}
+
+TEST_CASE("partition - datasets")
+{
+    Distribution distribution = GENERATE(from_range(all_distributions));
+    auto dataset = make_numbers(distribution, numbers.size(), no_of_items);
+    benchmark_results().set_dataset_size(dataset.size());
+
+    benchmark_on_copies(std::string{"partition - sequenced - "} + to_string(distribution), dataset, [](auto& data) {
+        return std::partition(data.begin(), data.end(), [](auto n) { return is_prime(n); });
+    });
+
+    benchmark_on_copies(std::string{"partition - parallel - "} + to_string(distribution), dataset, [](auto& data) {
+        return std::partition(std::execution::par_unseq, data.begin(), data.end(), [](auto n) { return is_prime(n); });
+    });
+}
+
+TEST_CASE("sort - datasets")
+{
+    Distribution distribution = GENERATE(from_range(all_distributions));
+
+    SECTION("numbers")
+    {
+        auto dataset = make_numbers(distribution, numbers.size(), UINT64_MAX);
+        benchmark_results().set_dataset_size(dataset.size());
+
+        benchmark_on_copies(std::string{"std::sort - numbers - "} + to_string(distribution), dataset, [](auto& data) {
+            std::sort(data.begin(), data.end());
+            return data.front();
+        });
+
+        benchmark_on_copies(std::string{"std::sort - parallel - numbers - "} + to_string(distribution), dataset, [](auto& data) {
+            std::sort(std::execution::par, data.begin(), data.end());
+            return data.front();
+        });
+    }
+
+    SECTION("words")
+    {
+        auto dataset = make_words(distribution, words.size(), vocabulary());
+        benchmark_results().set_dataset_size(dataset.size());
+
+        benchmark_on_copies(std::string{"std::sort - words - "} + to_string(distribution), dataset, [](auto& data) {
+            std::sort(data.begin(), data.end());
+            return data.front();
+        });
+
+        benchmark_on_copies(std::string{"std::sort - parallel - words - "} + to_string(distribution), dataset, [](auto& data) {
+            std::sort(std::execution::par, data.begin(), data.end());
+            return data.front();
+        });
+
+        benchmark_on_copies(std::string{"radix_sort - parallel - words - "} + to_string(distribution), dataset, [](auto& data) {
+            radix_sort(std::execution::par, data);
+            return data.front();
+        });
+    }
 }
\ No newline at end of file
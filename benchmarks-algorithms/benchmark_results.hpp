@@ -0,0 +1,226 @@
+#ifndef BENCHMARK_RESULTS_HPP
+#define BENCHMARK_RESULTS_HPP
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <cmath>
+#include <cstddef>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#if __has_include(<tbb/global_control.h>)
+#include <tbb/global_control.h>
+#define BENCHMARK_RESULTS_HAS_TBB 1
+#endif
+
+struct BenchmarkRecord
+{
+    std::string name;
+    double mean_ns;
+    double stddev_ns;
+    double min_ns;
+    size_t samples;
+    size_t threads;
+    size_t dataset_size; // 0 - not reported by the test case
+    std::optional<double> allocations{}; // per iteration - only when tracked with --allocations
+
+    // benchmarks rerun with other thread counts or datasets are different entries
+    auto key() const
+    {
+        return std::tie(name, threads, dataset_size);
+    }
+};
+
+struct BenchmarkRegression
+{
+    BenchmarkRecord baseline;
+    BenchmarkRecord current;
+    double slowdown; // current mean / baseline mean - 1
+    double t_statistic;
+    bool started_allocating = false; // allocation free in the baseline, allocating now
+};
+
+// collects results of all benchmarks of the run - filled by the listener in main.cpp
+class BenchmarkResults
+{
+    std::vector<BenchmarkRecord> records_;
+    size_t dataset_size_ = 0;
+
+public:
+    // number of elements processed by the benchmarks that follow
+    void set_dataset_size(size_t size) noexcept
+    {
+        dataset_size_ = size;
+    }
+
+    size_t dataset_size() const noexcept
+    {
+        return dataset_size_;
+    }
+
+    // parallelism limit the std::execution policies run with
+    static size_t thread_count()
+    {
+#ifdef BENCHMARK_RESULTS_HAS_TBB
+        return tbb::global_control::active_value(tbb::global_control::max_allowed_parallelism);
+#else
+        return std::thread::hardware_concurrency();
+#endif
+    }
+
+    void add(BenchmarkRecord record)
+    {
+        records_.push_back(std::move(record));
+    }
+
+    const std::vector<BenchmarkRecord>& records() const noexcept
+    {
+        return records_;
+    }
+
+    // the format is picked by the extension - .csv or anything else for JSON
+    void write(const std::string& file_name) const
+    {
+        std::ofstream out{file_name};
+
+        if (!out)
+            throw std::runtime_error("IO Error - cannot write " + file_name);
+
+        if (file_name.size() >= 4 && file_name.compare(file_name.size() - 4, 4, ".csv") == 0)
+            write_csv(out);
+        else
+            write_json(out);
+    }
+
+    void write_json(std::ostream& out) const
+    {
+        out << std::setprecision(std::numeric_limits<double>::max_digits10);
+        out << "{\n  \"benchmarks\": [";
+
+        for (size_t i = 0; i < records_.size(); ++i)
+        {
+            const auto& r = records_[i];
+            out << (i == 0 ? "\n" : ",\n")
+                << "    {\"name\": " << quoted(r.name, '"', '\\')
+                << ", \"mean_ns\": " << r.mean_ns
+                << ", \"stddev_ns\": " << r.stddev_ns
+                << ", \"min_ns\": " << r.min_ns
+                << ", \"samples\": " << r.samples
+                << ", \"threads\": " << r.threads
+                << ", \"dataset_size\": " << r.dataset_size;
+
+            if (r.allocations)
+                out << ", \"allocations\": " << *r.allocations;
+
+            out << "}";
+        }
+
+        out << "\n  ]\n}\n";
+    }
+
+    void write_csv(std::ostream& out) const
+    {
+        out << std::setprecision(std::numeric_limits<double>::max_digits10);
+        out << "name,mean_ns,stddev_ns,min_ns,samples,threads,dataset_size,allocations\n";
+
+        for (const auto& r : records_)
+        {
+            out << quoted(r.name, '"', '"') << ',' << r.mean_ns << ',' << r.stddev_ns << ',' << r.min_ns << ','
+                << r.samples << ',' << r.threads << ',' << r.dataset_size << ',';
+
+            if (r.allocations)
+                out << *r.allocations;
+
+            out << '\n';
+        }
+    }
+
+    // reads a file written by write_json()
+    static std::vector<BenchmarkRecord> load_json(const std::string& file_name)
+    {
+        boost::property_tree::ptree tree;
+        boost::property_tree::read_json(file_name, tree);
+
+        std::vector<BenchmarkRecord> records;
+        for (const auto& [key, benchmark] : tree.get_child("benchmarks"))
+        {
+            auto allocations = benchmark.get_optional<double>("allocations");
+
+            records.push_back(BenchmarkRecord{
+                benchmark.get<std::string>("name"),
+                benchmark.get<double>("mean_ns"),
+                benchmark.get<double>("stddev_ns"),
+                benchmark.get<double>("min_ns"),
+                benchmark.get<size_t>("samples"),
+                benchmark.get<size_t>("threads"),
+                benchmark.get<size_t>("dataset_size"),
+                allocations ? std::optional<double>{*allocations} : std::nullopt});
+        }
+
+        return records;
+    }
+
+    // a benchmark regresses when it is slower than the baseline by more than threshold (0.05 - 5%)
+    // and Welch's t statistic of the two sample sets exceeds t_critical, or when an allocation free benchmark
+    // (below 0.5 allocations per iteration - the runner's own bookkeeping) makes an allocation per iteration
+    std::vector<BenchmarkRegression> compare(const std::vector<BenchmarkRecord>& baseline, double threshold, double t_critical = 2.0) const
+    {
+        std::map<std::tuple<const std::string&, const size_t&, const size_t&>, const BenchmarkRecord*> baseline_by_key;
+        for (const auto& record : baseline)
+            baseline_by_key.emplace(record.key(), &record);
+
+        std::vector<BenchmarkRegression> regressions;
+
+        for (const auto& current : records_)
+        {
+            auto found = baseline_by_key.find(current.key());
+            if (found == baseline_by_key.end())
+                continue;
+
+            const BenchmarkRecord& base = *found->second;
+
+            double slowdown = current.mean_ns / base.mean_ns - 1.0;
+            double standard_error = std::sqrt(current.stddev_ns * current.stddev_ns / current.samples + base.stddev_ns * base.stddev_ns / base.samples);
+            double t = standard_error > 0 ? (current.mean_ns - base.mean_ns) / standard_error : std::numeric_limits<double>::infinity();
+
+            bool started_allocating = base.allocations && current.allocations && *base.allocations < 0.5 && *current.allocations >= 1.0;
+
+            if ((slowdown > threshold && t > t_critical) || started_allocating)
+                regressions.push_back(BenchmarkRegression{base, current, slowdown, t, started_allocating});
+        }
+
+        return regressions;
+    }
+
+private:
+    static std::string quoted(const std::string& text, char quote, char escape)
+    {
+        std::string result{quote};
+
+        for (char c : text)
+        {
+            if (c == quote || c == escape)
+                result += escape;
+            result += c;
+        }
+
+        return result += quote;
+    }
+};
+
+inline BenchmarkResults& benchmark_results()
+{
+    static BenchmarkResults results;
+    return results;
+}
+
+#endif // BENCHMARK_RESULTS_HPP
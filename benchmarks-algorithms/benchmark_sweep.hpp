@@ -0,0 +1,110 @@
+#ifndef BENCHMARK_SWEEP_HPP
+#define BENCHMARK_SWEEP_HPP
+
+#include "benchmark_results.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iomanip>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// reruns all benchmarks across a grid of thread counts and dataset scales - a dataset scale is
+// the fraction of the whole tokens.txt corpus (0.1 by default, above 1 the corpus is replicated)
+class BenchmarkSweep
+{
+public:
+    static constexpr double default_dataset_scale = 0.1;
+
+private:
+    inline static double dataset_scale_ = default_dataset_scale;
+
+    // function local - datasets register themselves from static initializers of other translation units
+    static std::vector<std::function<void(double)>>& datasets()
+    {
+        static std::vector<std::function<void(double)>> datasets;
+        return datasets;
+    }
+
+public:
+    // resize is called with the new scale before every run of the sweep
+    static bool register_dataset(std::function<void(double)> resize)
+    {
+        datasets().push_back(std::move(resize));
+        return true;
+    }
+
+    static double dataset_scale() noexcept
+    {
+        return dataset_scale_;
+    }
+
+    static void set_dataset_scale(double scale)
+    {
+        dataset_scale_ = scale;
+
+        for (const auto& resize : datasets())
+            resize(scale);
+    }
+
+    // "1,2,4" -> {1, 2, 4}
+    template <typename T>
+    static std::vector<T> parse_list(const std::string& text)
+    {
+        std::vector<T> values;
+        std::istringstream input{text};
+
+        for (std::string item; std::getline(input, item, ',');)
+        {
+            std::istringstream item_input{item};
+            T value;
+            if (item_input >> value)
+                values.push_back(value);
+        }
+
+        return values;
+    }
+
+    // one row per benchmark and dataset - speedup and efficiency against the smallest thread count
+    static void print_scaling_tables(const std::vector<BenchmarkRecord>& records, std::ostream& out)
+    {
+        std::map<std::pair<std::string, size_t>, std::map<size_t, double>> means; // (name, dataset) -> threads -> mean
+        std::vector<std::pair<std::string, size_t>> order;
+
+        for (const auto& r : records)
+        {
+            auto key = std::make_pair(r.name, r.dataset_size);
+            if (means.count(key) == 0)
+                order.push_back(key);
+            means[key][r.threads] = r.mean_ns;
+        }
+
+        out << "\nScaling - speedup (efficiency) against the smallest thread count\n";
+
+        for (const auto& key : order)
+        {
+            const auto& by_threads = means[key];
+            const auto& [base_threads, base_mean] = *by_threads.begin();
+
+            out << std::left << std::setw(60) << key.first << " n = " << std::setw(10) << key.second << std::right;
+
+            for (const auto& [threads, mean] : by_threads)
+            {
+                double speedup = base_mean / mean;
+                double efficiency = speedup * base_threads / threads;
+
+                out << "  " << threads << "T: " << std::fixed << std::setprecision(2) << speedup << "x ("
+                    << std::setprecision(0) << efficiency * 100 << "%)" << std::defaultfloat;
+            }
+
+            out << "\n";
+        }
+    }
+};
+
+#endif // BENCHMARK_SWEEP_HPP
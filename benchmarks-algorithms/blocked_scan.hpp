@@ -0,0 +1,142 @@
+#ifndef BLOCKED_SCAN_HPP
+#define BLOCKED_SCAN_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <execution>
+#include <functional>
+#include <numeric>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace blocked_scan_details
+{
+    constexpr size_t block_size = 16 * 1024; // elements - a block of 8-byte values fits into L2 between the two passes
+
+    // blocks scanned together - one per hardware thread, so a group of blocks fits into the L2 caches
+    inline size_t blocks_per_group() noexcept
+    {
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // tiled two pass scan - the range is processed one group of blocks at a time: 1. every block of the group is
+    // reduced to its sum, in parallel, 2. the sums are scanned sequentially starting from the carry of the groups
+    // before, 3. every block of the group is scanned again from the sum of the blocks before it, in parallel,
+    // while it is still in cache; reduce_block(first, last) returns a sum, scan_block(first, last, offset) writes
+    // the output of a block whose preceding blocks sum to offset (nullptr for the first block of the range)
+    template <typename T, typename ExecutionPolicy, typename BinaryOp, typename ReduceBlock, typename ScanBlock>
+    void scan_by_groups(ExecutionPolicy&& policy, size_t size, BinaryOp& op, ReduceBlock reduce_block, ScanBlock scan_block)
+    {
+        const size_t no_of_blocks = (size + block_size - 1) / block_size;
+        const size_t group_size = std::min(no_of_blocks, blocks_per_group());
+
+        std::vector<size_t> group_blocks(group_size);
+        std::vector<T> block_sums(group_size);
+        std::vector<std::optional<T>> offsets(group_size); // the sum of all blocks before - none for the first block
+        std::optional<T> carry;
+
+        for (size_t group_first = 0; group_first < no_of_blocks; group_first += group_size)
+        {
+            const size_t group_last = std::min(no_of_blocks, group_first + group_size);
+            group_blocks.resize(group_last - group_first);
+            std::iota(group_blocks.begin(), group_blocks.end(), group_first);
+
+            std::for_each(policy, group_blocks.begin(), group_blocks.end(), [&](size_t block) {
+                block_sums[block - group_first] = reduce_block(block * block_size, std::min(size, (block + 1) * block_size));
+            });
+
+            for (size_t i = 0; i < group_blocks.size(); ++i)
+            {
+                offsets[i] = carry;
+                carry = carry ? op(std::move(*carry), block_sums[i]) : std::move(block_sums[i]);
+            }
+
+            std::for_each(policy, group_blocks.begin(), group_blocks.end(), [&](size_t block) {
+                const auto& offset = offsets[block - group_first];
+                scan_block(block * block_size, std::min(size, (block + 1) * block_size), offset ? &*offset : nullptr);
+            });
+        }
+    }
+} // namespace blocked_scan_details
+
+// cache blocked inclusive scan - see scan_by_groups(); op has to be associative
+template <typename ExecutionPolicy, typename RandomIt, typename OutIt, typename BinaryOp, typename UnaryOp>
+OutIt blocked_transform_inclusive_scan(ExecutionPolicy&& policy, RandomIt first, RandomIt last, OutIt out, BinaryOp op, UnaryOp transform)
+{
+    using T = std::decay_t<decltype(transform(*first))>;
+
+    const size_t size = last - first;
+    if (size == 0)
+        return out;
+
+    if (size <= blocked_scan_details::block_size) // one block - the first pass would be wasted
+        return std::transform_inclusive_scan(first, last, out, op, transform);
+
+    auto reduce_block = [&](size_t block_first, size_t block_last) {
+        T sum = transform(first[block_first]);
+        for (size_t i = block_first + 1; i < block_last; ++i)
+            sum = op(std::move(sum), transform(first[i]));
+        return sum;
+    };
+
+    auto scan_block = [&](size_t block_first, size_t block_last, const T* offset) {
+        T sum = offset ? op(*offset, transform(first[block_first])) : transform(first[block_first]);
+        out[block_first] = sum;
+
+        for (size_t i = block_first + 1; i < block_last; ++i)
+        {
+            sum = op(std::move(sum), transform(first[i]));
+            out[i] = sum;
+        }
+    };
+
+    blocked_scan_details::scan_by_groups<T>(policy, size, op, reduce_block, scan_block);
+
+    return out + size;
+}
+
+template <typename ExecutionPolicy, typename RandomIt, typename OutIt, typename BinaryOp = std::plus<>>
+OutIt blocked_inclusive_scan(ExecutionPolicy&& policy, RandomIt first, RandomIt last, OutIt out, BinaryOp op = {})
+{
+    return blocked_transform_inclusive_scan(policy, first, last, out, op, [](const auto& x) { return x; });
+}
+
+// out[i] = init op first[0] op ... op first[i - 1] - out may be the input range (in place)
+template <typename ExecutionPolicy, typename RandomIt, typename OutIt, typename T, typename BinaryOp = std::plus<>>
+OutIt blocked_exclusive_scan(ExecutionPolicy&& policy, RandomIt first, RandomIt last, OutIt out, T init, BinaryOp op = {})
+{
+    const size_t size = last - first;
+    if (size == 0)
+        return out;
+
+    if (size <= blocked_scan_details::block_size)
+        return std::exclusive_scan(first, last, out, init, op);
+
+    auto reduce_block = [&](size_t block_first, size_t block_last) {
+        T sum = first[block_first];
+        for (size_t i = block_first + 1; i < block_last; ++i)
+            sum = op(std::move(sum), first[i]);
+        return sum;
+    };
+
+    // the block is read before out is written, so out may be the input range
+    auto scan_block = [&](size_t block_first, size_t block_last, const T* offset) {
+        T sum = offset ? op(init, *offset) : init;
+
+        for (size_t i = block_first; i < block_last; ++i)
+        {
+            T next = op(sum, first[i]);
+            out[i] = std::move(sum);
+            sum = std::move(next);
+        }
+    };
+
+    blocked_scan_details::scan_by_groups<T>(policy, size, op, reduce_block, scan_block);
+
+    return out + size;
+}
+
+#endif // BLOCKED_SCAN_HPP
@@ -0,0 +1,91 @@
+#ifndef COLLATION_HPP
+#define COLLATION_HPP
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <execution>
+#include <functional>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// lowercase copy of every word packed into one buffer - the keys are computed once per word
+// instead of twice per comparison
+template <typename Words>
+class CollationKeys
+{
+    std::string chars_;
+    std::vector<std::pair<std::string_view, size_t>> keys_; // (key, index of the original word)
+
+public:
+    // offsets of the keys are an exclusive scan of the word lengths, so every key is written independently
+    // with the policy
+    template <typename ExecutionPolicy>
+    CollationKeys(ExecutionPolicy&& policy, const Words& words)
+    {
+        std::vector<size_t> offsets(words.size());
+        std::transform_exclusive_scan(policy, words.begin(), words.end(), offsets.begin(), size_t{0}, std::plus<>{},
+            [](const auto& word) { return std::string_view{word}.size(); });
+
+        chars_.resize(words.empty() ? 0 : offsets.back() + std::string_view{words.back()}.size());
+        keys_.resize(words.size());
+
+        std::vector<size_t> indexes(words.size());
+        std::iota(indexes.begin(), indexes.end(), size_t{0});
+
+        // the buffer is sized up front - it does not reallocate, so the views stay valid
+        std::for_each(policy, indexes.begin(), indexes.end(), [&](size_t index) {
+            const std::string_view word{words[index]};
+            char* key = chars_.data() + offsets[index];
+
+            std::transform(word.begin(), word.end(), key, [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            keys_[index] = {std::string_view{key, word.size()}, index};
+        });
+    }
+
+    explicit CollationKeys(const Words& words)
+        : CollationKeys(std::execution::seq, words)
+    {
+    }
+
+    CollationKeys(const CollationKeys&) = delete;
+    CollationKeys& operator=(const CollationKeys&) = delete;
+
+    template <typename ExecutionPolicy>
+    void sort(ExecutionPolicy&& policy)
+    {
+        std::sort(std::forward<ExecutionPolicy>(policy), keys_.begin(), keys_.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    }
+
+    // reorders words to the order of the sorted keys
+    template <typename ExecutionPolicy>
+    void apply_order(ExecutionPolicy&& policy, Words& words) const
+    {
+        Words sorted_words(words.size());
+        std::transform(std::forward<ExecutionPolicy>(policy), keys_.begin(), keys_.end(), sorted_words.begin(),
+            [&words](const auto& key) { return std::move(words[key.second]); });
+        words = std::move(sorted_words);
+    }
+};
+
+// case-insensitive sort of std::vector<std::string> or std::vector<std::string_view> -
+// the same order as a comparator comparing boost::to_lower_copy of both words
+template <typename ExecutionPolicy, typename Words, typename = std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>>>
+void sort_case_insensitive(ExecutionPolicy&& policy, Words& words)
+{
+    CollationKeys<Words> keys{policy, words};
+    keys.sort(policy);
+    keys.apply_order(policy, words);
+}
+
+template <typename Words>
+void sort_case_insensitive(Words& words)
+{
+    sort_case_insensitive(std::execution::seq, words);
+}
+
+#endif // COLLATION_HPP
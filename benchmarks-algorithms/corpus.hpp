@@ -0,0 +1,407 @@
+#ifndef CORPUS_HPP
+#define CORPUS_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define CORPUS_HAS_MMAP 1
+#else
+#include <iterator>
+#endif
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define CORPUS_HAS_AVX2_KERNEL 1
+#endif
+
+// the same set of separators that operator>>(istream&, string&) skips in the "C" locale
+constexpr bool is_word_separator(char c) noexcept
+{
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+namespace corpus_details
+{
+    inline constexpr std::array<bool, 256> word_separator_table = [] {
+        std::array<bool, 256> table{};
+        for (size_t c = 0; c < table.size(); ++c)
+            table[c] = is_word_separator(static_cast<char>(c));
+        return table;
+    }();
+
+    // token_start - the start of a token begun before pos, nullptr between tokens
+    inline void tokenize_words_scalar(const char* pos, const char* end, const char*& token_start, std::vector<std::string_view>& words)
+    {
+        for (; pos != end; ++pos)
+        {
+            const bool separator = word_separator_table[static_cast<unsigned char>(*pos)];
+
+            if (token_start && separator)
+            {
+                words.emplace_back(token_start, pos - token_start);
+                token_start = nullptr;
+            }
+            else if (!token_start && !separator)
+            {
+                token_start = pos;
+            }
+        }
+    }
+
+#ifdef CORPUS_HAS_AVX2_KERNEL
+    // bit i set when p[i] is ' ' or one of '\t', '\n', '\v', '\f', '\r' (0x09 - 0x0D)
+    __attribute__((target("avx2"))) inline uint32_t word_separator_mask_avx2(const char* p) noexcept
+    {
+        const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        const __m256i space = _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(' '));
+        const __m256i control = _mm256_sub_epi8(chunk, _mm256_set1_epi8('\t'));
+        const __m256i is_control = _mm256_cmpeq_epi8(_mm256_min_epu8(control, _mm256_set1_epi8(4)), control);
+
+        return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(space, is_control)));
+    }
+
+    // 64 bytes at a time - a bit of boundaries is set where a token starts or ends, and starts and ends alternate;
+    // returns the position the scalar kernel has to continue from
+    __attribute__((target("avx2,bmi"))) inline const char* tokenize_words_avx2(const char* pos, const char* end, const char*& token_start, std::vector<std::string_view>& words)
+    {
+        uint64_t previous_in_token = token_start ? 1 : 0;
+
+        for (; end - pos >= 64; pos += 64)
+        {
+            const uint64_t separators = word_separator_mask_avx2(pos) | (static_cast<uint64_t>(word_separator_mask_avx2(pos + 32)) << 32);
+            const uint64_t in_token = ~separators;
+
+            uint64_t boundaries = in_token ^ ((in_token << 1) | previous_in_token);
+            previous_in_token = in_token >> 63;
+
+            for (; boundaries != 0; boundaries = _blsr_u64(boundaries))
+            {
+                const char* boundary = pos + _tzcnt_u64(boundaries);
+
+                if (token_start)
+                {
+                    words.emplace_back(token_start, boundary - token_start);
+                    token_start = nullptr;
+                }
+                else
+                {
+                    token_start = boundary;
+                }
+            }
+        }
+
+        return pos;
+    }
+
+    inline bool has_avx2() noexcept
+    {
+        static const bool supported = [] {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi");
+        }();
+
+        return supported;
+    }
+#endif
+} // namespace corpus_details
+
+// appends whitespace separated tokens of text to words - same tokens as load_words(); separators are found
+// 64 bytes at a time with AVX2 where the CPU has it, byte by byte with a lookup table otherwise
+inline void tokenize_words(std::string_view text, std::vector<std::string_view>& words)
+{
+    const char* pos = text.data();
+    const char* const end = text.data() + text.size();
+    const char* token_start = nullptr;
+
+#ifdef CORPUS_HAS_AVX2_KERNEL
+    if (corpus_details::has_avx2())
+        pos = corpus_details::tokenize_words_avx2(pos, end, token_start, words);
+#endif
+
+    corpus_details::tokenize_words_scalar(pos, end, token_start, words);
+
+    if (token_start)
+        words.emplace_back(token_start, end - token_start);
+}
+
+// tokenizes text on no_of_threads threads - the text is cut into equal byte ranges, every cut
+// is moved forward to the next separator, so no token straddles two chunks
+// and the joined result is the same as the result of tokenize_words()
+inline std::vector<std::string_view> tokenize_words_parallel(std::string_view text, size_t no_of_threads)
+{
+    no_of_threads = std::clamp<size_t>(no_of_threads, 1, std::max<size_t>(text.size(), 1));
+
+    std::vector<size_t> cuts(no_of_threads + 1);
+    cuts.front() = 0;
+    cuts.back() = text.size();
+
+    for (size_t i = 1; i < no_of_threads; ++i)
+    {
+        size_t cut = std::max(i * (text.size() / no_of_threads), cuts[i - 1]);
+
+        while (cut != text.size() && !is_word_separator(text[cut]))
+            ++cut;
+
+        cuts[i] = cut;
+    }
+
+    auto tokenize_chunk = [text](size_t first, size_t last) {
+        std::vector<std::string_view> chunk_words;
+        chunk_words.reserve((last - first) / 6);
+        tokenize_words(text.substr(first, last - first), chunk_words);
+        return chunk_words;
+    };
+
+    std::vector<std::future<std::vector<std::string_view>>> chunks;
+    chunks.reserve(no_of_threads - 1);
+
+    for (size_t i = 1; i < no_of_threads; ++i)
+        chunks.push_back(std::async(std::launch::async, tokenize_chunk, cuts[i], cuts[i + 1]));
+
+    std::vector<std::string_view> words = tokenize_chunk(cuts[0], cuts[1]); // the first chunk is done by the calling thread
+
+    for (auto& chunk : chunks)
+    {
+        auto chunk_words = chunk.get();
+        words.insert(words.end(), chunk_words.begin(), chunk_words.end());
+    }
+
+    return words;
+}
+
+// read-only view of a whole file - memory mapped where the platform allows it
+class MappedFile
+{
+#ifdef CORPUS_HAS_MMAP
+    void* data_ = nullptr;
+    size_t size_ = 0;
+#else
+    std::vector<char> buffer_; // unlike std::string (SSO) its data survives a move
+#endif
+
+public:
+    explicit MappedFile(const std::string& file_name)
+    {
+#ifdef CORPUS_HAS_MMAP
+        int fd = ::open(file_name.c_str(), O_RDONLY);
+        if (fd == -1)
+            throw std::runtime_error("IO Error - file not found");
+
+        struct stat file_stat{};
+        if (::fstat(fd, &file_stat) == -1)
+        {
+            ::close(fd);
+            throw std::runtime_error("IO Error - cannot stat file");
+        }
+
+        size_ = static_cast<size_t>(file_stat.st_size);
+
+        if (size_ > 0)
+        {
+            data_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data_ == MAP_FAILED)
+            {
+                ::close(fd);
+                throw std::runtime_error("IO Error - cannot map file");
+            }
+
+            ::madvise(data_, size_, MADV_SEQUENTIAL);
+        }
+
+        ::close(fd); // mapping stays valid after the descriptor is closed
+#else
+        std::ifstream input_file{file_name, std::ios::binary};
+
+        if (!input_file)
+            throw std::runtime_error("IO Error - file not found");
+
+        buffer_.assign(std::istreambuf_iterator<char>{input_file}, std::istreambuf_iterator<char>{});
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+#ifdef CORPUS_HAS_MMAP
+    MappedFile(MappedFile&& other) noexcept
+        : data_{std::exchange(other.data_, nullptr)}, size_{std::exchange(other.size_, 0)}
+    {
+    }
+
+    MappedFile& operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            unmap();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+
+        return *this;
+    }
+
+    ~MappedFile()
+    {
+        unmap();
+    }
+
+    std::string_view content() const noexcept
+    {
+        return {static_cast<const char*>(data_), size_};
+    }
+
+private:
+    void unmap() noexcept
+    {
+        if (data_)
+            ::munmap(data_, size_);
+    }
+#else
+    MappedFile(MappedFile&&) noexcept = default;
+    MappedFile& operator=(MappedFile&&) noexcept = default;
+
+    std::string_view content() const noexcept
+    {
+        return {buffer_.data(), buffer_.size()};
+    }
+#endif
+};
+
+// tokens pointing straight into a mapped file - views are valid as long as the object lives
+class MappedWords
+{
+    MappedFile file_;
+    std::vector<std::string_view> words_;
+
+public:
+    using value_type = std::string_view;
+    using const_iterator = std::vector<std::string_view>::const_iterator;
+    using iterator = const_iterator;
+
+    explicit MappedWords(const std::string& file_name)
+        : file_{file_name}
+    {
+        auto text = file_.content();
+        words_.reserve(text.size() / 6); // rough guess: average word + separator
+        tokenize_words(text, words_);
+    }
+
+    MappedWords(const std::string& file_name, size_t no_of_threads)
+        : file_{file_name}, words_{tokenize_words_parallel(file_.content(), no_of_threads)}
+    {
+    }
+
+    // moving the mapping does not move the mapped pages, so the views stay valid
+    MappedWords(MappedWords&&) noexcept = default;
+    MappedWords& operator=(MappedWords&&) noexcept = default;
+
+    const std::vector<std::string_view>& words() const noexcept
+    {
+        return words_;
+    }
+
+    std::string_view content() const noexcept
+    {
+        return file_.content();
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return words_.begin();
+    }
+
+    const_iterator end() const noexcept
+    {
+        return words_.end();
+    }
+
+    size_t size() const noexcept
+    {
+        return words_.size();
+    }
+
+    std::string_view operator[](size_t index) const noexcept
+    {
+        return words_[index];
+    }
+};
+
+inline MappedWords load_words_mapped(const std::string& file_name)
+{
+    return MappedWords{file_name};
+}
+
+inline MappedWords load_words_parallel(const std::string& file_name, size_t no_of_threads)
+{
+    return MappedWords{file_name, no_of_threads};
+}
+
+// streams whitespace separated tokens of a file through a buffer of buffer_size bytes - on_batch(words) is called
+// with the tokens of every buffer, views valid only during the call; a token cut by the end of the buffer
+// is carried over to the front of the next one, so memory stays constant whatever the size of the file
+// (the buffer grows only for a token longer than itself); the tokens are the same as those of load_words() -
+// returns their number
+template <typename OnBatch>
+size_t stream_words(const std::string& file_name, OnBatch on_batch, size_t buffer_size = 1 << 20)
+{
+    std::ifstream input_file{file_name, std::ios::binary};
+
+    if (!input_file)
+        throw std::runtime_error("IO Error - file not found");
+
+    std::vector<char> buffer(std::max<size_t>(buffer_size, 1));
+    std::vector<std::string_view> batch;
+    size_t carry = 0; // bytes of the partial token at the front of the buffer
+    size_t no_of_words = 0;
+
+    for (bool end_of_file = false; !end_of_file;)
+    {
+        if (carry == buffer.size())
+            buffer.resize(2 * buffer.size());
+
+        input_file.read(buffer.data() + carry, buffer.size() - carry);
+
+        if (input_file.bad())
+            throw std::runtime_error("IO Error - cannot read file");
+
+        end_of_file = input_file.eof();
+
+        const std::string_view text{buffer.data(), carry + static_cast<size_t>(input_file.gcount())};
+
+        // tokens up to the last separator are complete - the rest may continue in the next buffer
+        size_t complete = text.size();
+        if (!end_of_file)
+            complete = std::find_if(text.rbegin(), text.rend(), is_word_separator).base() - text.begin();
+
+        batch.clear();
+        tokenize_words(text.substr(0, complete), batch);
+
+        if (!batch.empty())
+        {
+            on_batch(std::as_const(batch));
+            no_of_words += batch.size();
+        }
+
+        carry = text.size() - complete;
+        if (complete != 0)
+            std::copy(text.begin() + complete, text.end(), buffer.begin());
+    }
+
+    return no_of_words;
+}
+
+#endif // CORPUS_HPP
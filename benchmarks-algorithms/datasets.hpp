@@ -0,0 +1,161 @@
+#ifndef DATASETS_HPP
+#define DATASETS_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// synthetic inputs for the benchmarks - the same seed always gives the same dataset
+enum class Distribution
+{
+    uniform,
+    sorted,
+    reverse_sorted,
+    few_unique,
+    zipf
+};
+
+inline constexpr std::array<Distribution, 5> all_distributions = {
+    Distribution::uniform, Distribution::sorted, Distribution::reverse_sorted, Distribution::few_unique, Distribution::zipf};
+
+inline constexpr uint64_t default_dataset_seed = 20201130;
+
+inline const char* to_string(Distribution distribution)
+{
+    switch (distribution)
+    {
+    case Distribution::uniform:
+        return "uniform";
+    case Distribution::sorted:
+        return "sorted";
+    case Distribution::reverse_sorted:
+        return "reverse sorted";
+    case Distribution::few_unique:
+        return "few unique";
+    case Distribution::zipf:
+        return "zipf";
+    }
+
+    throw std::invalid_argument("unknown distribution");
+}
+
+namespace datasets_details
+{
+    constexpr size_t no_of_few_unique = 16;
+    constexpr size_t max_zipf_ranks = size_t{1} << 20; // caps the size of the cumulative table
+    constexpr double zipf_exponent = 1.0;
+
+    // Zipf's law over ranks 0..no_of_ranks-1 - rank r is drawn with probability proportional to 1 / (r + 1)^s
+    class ZipfDistribution
+    {
+        std::vector<double> cdf_;
+
+    public:
+        explicit ZipfDistribution(size_t no_of_ranks, double exponent = zipf_exponent)
+            : cdf_(std::max<size_t>(no_of_ranks, 1))
+        {
+            double total = 0.0;
+            for (size_t r = 0; r < cdf_.size(); ++r)
+                cdf_[r] = total += 1.0 / std::pow(static_cast<double>(r + 1), exponent);
+
+            for (auto& p : cdf_)
+                p /= total;
+        }
+
+        template <typename Generator>
+        size_t operator()(Generator& gen) const
+        {
+            double u = std::uniform_real_distribution<double>{0.0, 1.0}(gen);
+            return std::min<size_t>(std::lower_bound(cdf_.begin(), cdf_.end(), u) - cdf_.begin(), cdf_.size() - 1);
+        }
+    };
+
+    // calls draw(index) size times with indexes from 0..max_index following the distribution - ordering is left to the caller
+    template <typename Draw>
+    void draw_indexes(Distribution distribution, size_t size, uint64_t max_index, uint64_t seed, Draw draw)
+    {
+        std::mt19937_64 gen{seed};
+        std::uniform_int_distribution<uint64_t> index(0, max_index);
+
+        switch (distribution)
+        {
+        case Distribution::uniform:
+        case Distribution::sorted:
+        case Distribution::reverse_sorted:
+            for (size_t i = 0; i < size; ++i)
+                draw(index(gen));
+            break;
+
+        case Distribution::few_unique:
+        {
+            std::array<uint64_t, no_of_few_unique> unique_indexes;
+            std::generate(unique_indexes.begin(), unique_indexes.end(), [&] { return index(gen); });
+
+            std::uniform_int_distribution<size_t> pick(0, unique_indexes.size() - 1);
+            for (size_t i = 0; i < size; ++i)
+                draw(unique_indexes[pick(gen)]);
+            break;
+        }
+
+        case Distribution::zipf:
+        {
+            ZipfDistribution rank(static_cast<size_t>(std::min<uint64_t>(max_index, max_zipf_ranks - 1)) + 1);
+            for (size_t i = 0; i < size; ++i)
+                draw(rank(gen));
+            break;
+        }
+        }
+    }
+
+    template <typename T>
+    void order(std::vector<T>& values, Distribution distribution)
+    {
+        if (distribution == Distribution::sorted)
+            std::sort(values.begin(), values.end());
+        else if (distribution == Distribution::reverse_sorted)
+            std::sort(values.begin(), values.end(), std::greater<>{});
+    }
+} // namespace datasets_details
+
+// size integers from 0..max_value - zipf makes the small values the most frequent,
+// above 2^20 values its ranks are spread evenly over the range
+inline std::vector<uint64_t> make_numbers(Distribution distribution, size_t size, uint64_t max_value, uint64_t seed = default_dataset_seed)
+{
+    const uint64_t max_rank = std::min<uint64_t>(max_value, datasets_details::max_zipf_ranks - 1);
+    const uint64_t zipf_stride = max_rank > 0 ? max_value / max_rank : 0;
+
+    std::vector<uint64_t> numbers;
+    numbers.reserve(size);
+
+    if (distribution == Distribution::zipf)
+        datasets_details::draw_indexes(distribution, size, max_rank, seed, [&](uint64_t rank) { numbers.push_back(rank * zipf_stride); });
+    else
+        datasets_details::draw_indexes(distribution, size, max_value, seed, [&](uint64_t value) { numbers.push_back(value); });
+
+    datasets_details::order(numbers, distribution);
+    return numbers;
+}
+
+// size words drawn from vocabulary - zipf makes the words at the front of the vocabulary the most frequent
+inline std::vector<std::string> make_words(Distribution distribution, size_t size, const std::vector<std::string>& vocabulary, uint64_t seed = default_dataset_seed)
+{
+    if (vocabulary.empty())
+        throw std::invalid_argument("make_words - empty vocabulary");
+
+    std::vector<std::string> words;
+    words.reserve(size);
+
+    datasets_details::draw_indexes(distribution, size, vocabulary.size() - 1, seed, [&](uint64_t index) { words.push_back(vocabulary[index]); });
+
+    datasets_details::order(words, distribution);
+    return words;
+}
+
+#endif // DATASETS_HPP
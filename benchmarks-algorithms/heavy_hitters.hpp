@@ -0,0 +1,230 @@
+#ifndef HEAVY_HITTERS_HPP
+#define HEAVY_HITTERS_HPP
+
+#include "string_hash.hpp"
+#include "word_count.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Count-Min sketch - depth rows of width counters; an estimate never undercounts and, with probability
+// at least 1 - delta(), overcounts by at most epsilon() * total() (Cormode, Muthukrishnan)
+class CountMinSketch
+{
+    size_t width_;
+    size_t depth_;
+    std::vector<uint64_t> counters_;
+    uint64_t total_ = 0;
+
+public:
+    // width is rounded up to a power of two
+    explicit CountMinSketch(size_t width = 4096, size_t depth = 4)
+        : width_{std::max<size_t>(1, size_t{1} << static_cast<size_t>(std::ceil(std::log2(std::max<size_t>(width, 1)))))}
+        , depth_{std::max<size_t>(depth, 1)}
+        , counters_(width_ * depth_)
+    {
+    }
+
+    // returns the estimate of word after the update
+    uint64_t add(std::string_view word, uint64_t count = 1)
+    {
+        total_ += count;
+
+        uint64_t estimate = UINT64_MAX;
+        for_each_index(word, [&](size_t index) {
+            counters_[index] += count;
+            estimate = std::min(estimate, counters_[index]);
+        });
+
+        return estimate;
+    }
+
+    uint64_t estimate(std::string_view word) const
+    {
+        uint64_t estimate = UINT64_MAX;
+        for_each_index(word, [&](size_t index) { estimate = std::min(estimate, counters_[index]); });
+        return estimate;
+    }
+
+    // sketches of the same shape add up - the result is the sketch of both streams
+    void merge(const CountMinSketch& other)
+    {
+        if (width_ != other.width_ || depth_ != other.depth_)
+            throw std::invalid_argument("CountMinSketch - merged sketches must have the same width and depth");
+
+        std::transform(counters_.begin(), counters_.end(), other.counters_.begin(), counters_.begin(), std::plus{});
+        total_ += other.total_;
+    }
+
+    size_t width() const noexcept
+    {
+        return width_;
+    }
+
+    size_t depth() const noexcept
+    {
+        return depth_;
+    }
+
+    uint64_t total() const noexcept
+    {
+        return total_;
+    }
+
+    double epsilon() const noexcept
+    {
+        return std::exp(1.0) / width_;
+    }
+
+    double delta() const noexcept
+    {
+        return std::exp(-static_cast<double>(depth_));
+    }
+
+    double error_bound() const noexcept
+    {
+        return epsilon() * total_;
+    }
+
+    size_t memory_bytes() const noexcept
+    {
+        return counters_.size() * sizeof(uint64_t);
+    }
+
+private:
+    // row indexes from one 64-bit hash - h1 + i * h2 (Kirsch, Mitzenmacher)
+    template <typename F>
+    void for_each_index(std::string_view word, F f) const
+    {
+        const uint64_t hash = WyHash{}(word);
+        const uint64_t h1 = hash;
+        const uint64_t h2 = (hash >> 32) | 1;
+
+        for (size_t row = 0; row < depth_; ++row)
+            f(row * width_ + ((h1 + row * h2) & (width_ - 1)));
+    }
+};
+
+// streaming top-k words - counts come from a Count-Min sketch and only the 2k words with the highest estimates
+// are kept, so the memory footprint is fixed; the extra k candidates keep words ranked just below k in every
+// instance alive for merge(), where their merged estimates may put them into the top k;
+// the words are views into the corpus, which has to outlive it
+class HeavyHitters
+{
+    CountMinSketch sketch_;
+    size_t k_;
+    size_t capacity_; // candidates kept - 2k
+    std::vector<std::pair<std::string_view, uint64_t>> candidates_;
+    std::unordered_map<std::string_view, size_t> candidate_index_;
+    uint64_t min_estimate_ = 0; // never above the smallest estimate of the candidates - they only grow
+
+public:
+    explicit HeavyHitters(size_t k, size_t width = 4096, size_t depth = 4)
+        : sketch_{width, depth}, k_{std::max<size_t>(k, 1)}, capacity_{2 * k_}
+    {
+        candidates_.reserve(capacity_);
+        candidate_index_.reserve(capacity_);
+    }
+
+    void add(std::string_view word)
+    {
+        offer(word, sketch_.add(word));
+    }
+
+    // the candidates of both are estimated again with the merged sketch and the best 2k are kept
+    void merge(const HeavyHitters& other)
+    {
+        sketch_.merge(other.sketch_);
+
+        auto words = std::move(candidates_);
+        words.insert(words.end(), other.candidates_.begin(), other.candidates_.end());
+
+        candidates_.clear();
+        candidate_index_.clear();
+        min_estimate_ = 0;
+
+        for (const auto& [word, estimate] : words)
+            offer(word, sketch_.estimate(word));
+    }
+
+    // k words with the highest estimates first
+    std::vector<std::pair<std::string_view, uint64_t>> top() const
+    {
+        auto result = candidates_;
+        std::sort(result.begin(), result.end(), [](const auto& a, const auto& b) { return a.second > b.second || (a.second == b.second && a.first < b.first); });
+        result.resize(std::min(result.size(), k_));
+        return result;
+    }
+
+    const CountMinSketch& sketch() const noexcept
+    {
+        return sketch_;
+    }
+
+    size_t k() const noexcept
+    {
+        return k_;
+    }
+
+private:
+    // O(1) for words already among the candidates and words below the threshold, O(k) for an eviction
+    void offer(std::string_view word, uint64_t estimate)
+    {
+        if (candidates_.size() == capacity_ && estimate < min_estimate_) // a candidate is estimated at least min_estimate_
+            return;
+
+        if (auto it = candidate_index_.find(word); it != candidate_index_.end())
+        {
+            candidates_[it->second].second = estimate;
+            return;
+        }
+
+        if (candidates_.size() < capacity_)
+        {
+            candidate_index_.emplace(word, candidates_.size());
+            candidates_.emplace_back(word, estimate);
+            return;
+        }
+
+        if (estimate <= min_estimate_)
+            return;
+
+        auto smallest = std::min_element(candidates_.begin(), candidates_.end(), [](const auto& a, const auto& b) { return a.second < b.second; });
+        min_estimate_ = smallest->second;
+
+        if (estimate <= min_estimate_)
+            return;
+
+        candidate_index_.erase(smallest->first);
+        candidate_index_.emplace(word, smallest - candidates_.begin());
+        *smallest = {word, estimate};
+
+        min_estimate_ = std::min_element(candidates_.begin(), candidates_.end(), [](const auto& a, const auto& b) { return a.second < b.second; })->second;
+    }
+};
+
+// one instance per thread on its slice of the words - the instances are merged at the end
+template <typename Words>
+HeavyHitters heavy_hitters_parallel(const Words& words, size_t no_of_threads, size_t k, size_t width = 4096, size_t depth = 4)
+{
+    std::vector<HeavyHitters> local(std::clamp<size_t>(no_of_threads, 1, std::max<size_t>(std::size(words), 1)), HeavyHitters{k, width, depth});
+
+    word_count_details::for_each_chunk(words, no_of_threads, [&](auto first, auto last, size_t thread_index) {
+        for (; first != last; ++first)
+            local[thread_index].add(std::string_view{*first});
+    });
+
+    for (size_t i = 1; i < local.size(); ++i)
+        local.front().merge(local[i]);
+
+    return std::move(local.front());
+}
+
+#endif // HEAVY_HITTERS_HPP
@@ -1,4 +1,269 @@
-#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_RUNNER
 #define CATCH_CONFIG_ENABLE_BENCHMARKING
 
-#include "catch.hpp"
\ No newline at end of file
+#include "catch.hpp"
+
+#include "allocation_tracker.hpp"
+#include "benchmark_results.hpp"
+#include "benchmark_sweep.hpp"
+#include "perf_counters.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <sstream>
+
+// opt-in with --allocations - heap allocations are counted from benchmarkStarting to benchmarkEnded
+// (a few of them are made by Catch itself, once per benchmark) and printed per iteration when the test case ends; registered first, so the count is ready
+// when BenchmarkResultsListener records the benchmark
+class AllocationsListener : public Catch::TestEventListenerBase
+{
+    std::vector<std::string> pending_reports_;
+
+public:
+    inline static bool enabled = false;
+    inline static std::optional<double> last_allocations; // per iteration
+
+    using TestEventListenerBase::TestEventListenerBase;
+
+    void benchmarkStarting(Catch::BenchmarkInfo const&) override
+    {
+        if (enabled)
+            AllocationTracker::start();
+    }
+
+    void benchmarkEnded(Catch::BenchmarkStats<> const& stats) override
+    {
+        if (!enabled)
+            return;
+
+        auto allocations = AllocationTracker::stop();
+        const double iterations = static_cast<double>(stats.samples.size()) * stats.info.iterations;
+
+        last_allocations = allocations.count / iterations;
+
+        std::ostringstream report;
+        report << "allocations - " << stats.info.name << " (per iteration): "
+               << std::fixed << std::setprecision(2) << *last_allocations << " allocations, "
+               << std::setprecision(0) << allocations.bytes / iterations << " bytes"
+#ifdef ALLOCATION_TRACKER_HAS_USABLE_SIZE
+               << ", peak live: " << allocations.peak_live_bytes << " bytes"
+#endif
+            ;
+
+        pending_reports_.push_back(report.str());
+    }
+
+    void testCaseEnded(Catch::TestCaseStats const&) override
+    {
+        for (const auto& report : pending_reports_)
+            std::cout << report << "\n";
+
+        pending_reports_.clear();
+    }
+};
+
+CATCH_REGISTER_LISTENER(AllocationsListener)
+
+class BenchmarkResultsListener : public Catch::TestEventListenerBase
+{
+public:
+    using TestEventListenerBase::TestEventListenerBase;
+
+    void benchmarkEnded(Catch::BenchmarkStats<> const& stats) override
+    {
+        double min_ns = stats.samples.empty() ? 0.0 : std::min_element(stats.samples.begin(), stats.samples.end())->count();
+
+        benchmark_results().add(BenchmarkRecord{
+            stats.info.name,
+            stats.mean.point.count(),
+            stats.standardDeviation.point.count(),
+            min_ns,
+            stats.samples.size(),
+            BenchmarkResults::thread_count(),
+            benchmark_results().dataset_size(),
+            AllocationsListener::last_allocations});
+    }
+};
+
+CATCH_REGISTER_LISTENER(BenchmarkResultsListener)
+
+// opt-in with --perf-counters - counts are collected from benchmarkStarting to benchmarkEnded
+// and printed per iteration when the test case ends, so they do not break the console table
+class PerfCountersListener : public Catch::TestEventListenerBase
+{
+    std::vector<std::string> pending_reports_;
+
+public:
+    inline static std::unique_ptr<PerfCounters> counters;
+
+    using TestEventListenerBase::TestEventListenerBase;
+
+    void benchmarkStarting(Catch::BenchmarkInfo const&) override
+    {
+        if (counters && counters->available())
+            counters->start();
+    }
+
+    void benchmarkEnded(Catch::BenchmarkStats<> const& stats) override
+    {
+        if (!counters || !counters->available())
+            return;
+
+        counters->stop();
+
+        const double iterations = static_cast<double>(stats.samples.size()) * stats.info.iterations;
+        auto values = counters->read();
+
+        std::ostringstream report;
+        report << "perf counters - " << stats.info.name << " (per iteration):";
+
+        std::optional<double> cycles, instructions;
+        for (const auto& [name, value] : values)
+        {
+            report << "  " << name << ": ";
+
+            if (value)
+                report << std::fixed << std::setprecision(0) << *value / iterations;
+            else
+                report << "n/a";
+
+            if (name == "cycles")
+                cycles = value;
+            else if (name == "instructions")
+                instructions = value;
+        }
+
+        if (cycles && instructions && *cycles > 0)
+            report << "  IPC: " << std::setprecision(2) << *instructions / *cycles;
+
+        pending_reports_.push_back(report.str());
+    }
+
+    void testCaseEnded(Catch::TestCaseStats const&) override
+    {
+        for (const auto& report : pending_reports_)
+            std::cout << report << "\n";
+
+        pending_reports_.clear();
+    }
+};
+
+CATCH_REGISTER_LISTENER(PerfCountersListener)
+
+int main(int argc, char* argv[])
+{
+    Catch::Session session;
+
+    std::string results_file;
+    std::string baseline_file;
+    double regression_threshold = 0.05;
+    std::string sweep_threads;
+    std::string sweep_scales;
+    bool perf_counters = false;
+    bool perf_counters_system_wide = false;
+    bool allocations = false;
+
+    using namespace Catch::clara;
+    session.cli(session.cli()
+        | Opt(results_file, "file")["--results"]("write benchmark results to a .json or .csv file")
+        | Opt(baseline_file, "file")["--baseline"]("fail when a benchmark is significantly slower than in this .json file")
+        | Opt(regression_threshold, "fraction")["--regression-threshold"]("allowed slowdown against the baseline (default: 0.05)")
+        | Opt(sweep_threads, "1,2,4,...")["--sweep-threads"]("rerun the benchmarks with each TBB thread limit")
+        | Opt(sweep_scales, "0.1,1,10")["--sweep-scales"]("rerun the benchmarks on each fraction of the corpus (above 1 - replicated)")
+        | Opt(perf_counters)["--perf-counters"]("report hardware counters per benchmark (Linux, implies --benchmark-no-analysis)")
+        | Opt(perf_counters_system_wide)["--perf-counters-system-wide"]("count on every CPU, other processes included (implies --perf-counters)")
+        | Opt(allocations)["--allocations"]("report heap allocations per benchmark (implies --benchmark-no-analysis)"));
+
+    if (int result = session.applyCommandLine(argc, argv); result != 0)
+        return result;
+
+    if (perf_counters || perf_counters_system_wide)
+    {
+        PerfCountersListener::counters = std::make_unique<PerfCounters>(perf_counters_system_wide);
+
+        if (PerfCountersListener::counters->available())
+        {
+            std::cout << "perf counters - scope: "
+                      << (PerfCountersListener::counters->scope() == PerfCounters::Scope::system_wide ? "system wide" : "calling thread and threads it spawns") << "\n";
+
+            // bootstrap analysis and clock warm-up would be counted as part of the benchmark
+            session.configData().benchmarkNoAnalysis = true;
+            session.configData().benchmarkWarmupTime = 0;
+        }
+        else
+        {
+            std::cout << "perf counters - unavailable, timing only: " << PerfCountersListener::counters->error() << "\n";
+        }
+    }
+
+    if (allocations)
+    {
+        AllocationsListener::enabled = true;
+        session.configData().benchmarkNoAnalysis = true; // the bootstrap analysis allocates before benchmarkEnded
+    }
+
+    int result = 0;
+
+    if (sweep_threads.empty() && sweep_scales.empty())
+    {
+        result = session.run();
+    }
+    else
+    {
+        auto thread_counts = BenchmarkSweep::parse_list<size_t>(sweep_threads);
+        auto scales = BenchmarkSweep::parse_list<double>(sweep_scales);
+
+        if (thread_counts.empty())
+            thread_counts.push_back(BenchmarkResults::thread_count());
+        if (scales.empty())
+            scales.push_back(BenchmarkSweep::default_dataset_scale);
+
+        for (double scale : scales)
+        {
+            BenchmarkSweep::set_dataset_scale(scale);
+
+            for (size_t threads : thread_counts)
+            {
+                std::cout << "\n### Sweep - dataset scale: " << scale << ", threads: " << threads << "\n";
+#ifdef BENCHMARK_RESULTS_HAS_TBB
+                tbb::global_control thread_limit{tbb::global_control::max_allowed_parallelism, threads};
+#else
+                std::cerr << "Thread limit is not supported without TBB - running with the default\n";
+#endif
+                result = std::max(result, session.run());
+            }
+        }
+
+        BenchmarkSweep::print_scaling_tables(benchmark_results().records(), std::cout);
+    }
+
+    if (!results_file.empty())
+        benchmark_results().write(results_file);
+
+    if (!baseline_file.empty())
+    {
+        auto regressions = benchmark_results().compare(BenchmarkResults::load_json(baseline_file), regression_threshold);
+
+        for (const auto& regression : regressions)
+        {
+            if (regression.started_allocating)
+            {
+                std::cerr << "REGRESSION: " << regression.current.name << " - allocation free in the baseline, now "
+                          << *regression.current.allocations << " allocations per iteration\n";
+                continue;
+            }
+
+            std::cerr << "REGRESSION: " << regression.current.name
+                      << " - mean " << regression.baseline.mean_ns << " ns -> " << regression.current.mean_ns << " ns"
+                      << " (+" << regression.slowdown * 100 << "%, t = " << regression.t_statistic << ")\n";
+        }
+
+        if (!regressions.empty() && result == 0)
+            result = 1;
+    }
+
+    return result;
+}
@@ -0,0 +1,119 @@
+#ifndef MILLER_RABIN_HPP
+#define MILLER_RABIN_HPP
+
+#include <cstdint>
+#include <initializer_list>
+
+namespace miller_rabin_details
+{
+    inline uint64_t mul_mod(uint64_t a, uint64_t b, uint64_t m) noexcept
+    {
+#ifdef __SIZEOF_INT128__
+        return static_cast<uint64_t>(static_cast<unsigned __int128>(a) * b % m);
+#else
+        // no 128-bit integers (MSVC) - shift-and-add, slow but portable
+        uint64_t result = 0;
+        a %= m;
+
+        for (; b > 0; b >>= 1)
+        {
+            if (b & 1)
+                result = (result >= m - a) ? result - (m - a) : result + a;
+
+            a = (a >= m - a) ? a - (m - a) : a + a;
+        }
+
+        return result;
+#endif
+    }
+
+    inline uint64_t pow_mod(uint64_t base, uint64_t exponent, uint64_t m) noexcept
+    {
+        uint64_t result = 1;
+        base %= m;
+
+        while (exponent > 0)
+        {
+            if (exponent & 1)
+                result = mul_mod(result, base, m);
+
+            base = mul_mod(base, base, m);
+            exponent >>= 1;
+        }
+
+        return result;
+    }
+
+    // n - 1 == d * 2^s with d odd
+    inline bool is_strong_probable_prime(uint64_t n, uint64_t witness, uint64_t d, unsigned s) noexcept
+    {
+        uint64_t x = pow_mod(witness, d, n);
+
+        if (x == 1 || x == n - 1)
+            return true;
+
+        for (unsigned r = 1; r < s; ++r)
+        {
+            x = mul_mod(x, x, n);
+
+            if (x == n - 1)
+                return true;
+        }
+
+        return false;
+    }
+} // namespace miller_rabin_details
+
+// deterministic Miller-Rabin - the witness set is the smallest known one without false positives for the range of n
+inline bool is_prime_u64(uint64_t n) noexcept
+{
+    using namespace miller_rabin_details;
+
+    constexpr uint64_t small_primes[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+
+    if (n < 2)
+        return false;
+
+    // trial division rejects most composites before any modular exponentiation
+    for (uint64_t p : small_primes)
+    {
+        if (n % p == 0)
+            return n == p;
+    }
+
+    if (n < 41 * 41)
+        return true;
+
+    uint64_t d = n - 1;
+    unsigned s = 0;
+    while (d % 2 == 0)
+    {
+        d /= 2;
+        ++s;
+    }
+
+    auto passes_all = [=](std::initializer_list<uint64_t> witnesses) {
+        for (uint64_t witness : witnesses)
+        {
+            if (!is_strong_probable_prime(n, witness, d, s))
+                return false;
+        }
+        return true;
+    };
+
+    if (n < 2'047)
+        return passes_all({2});
+    if (n < 1'373'653)
+        return passes_all({2, 3});
+    if (n < 25'326'001)
+        return passes_all({2, 3, 5});
+    if (n < 3'215'031'751)
+        return passes_all({2, 3, 5, 7});
+    if (n < 4'759'123'141)
+        return passes_all({2, 7, 61});
+
+    // Jim Sinclair's set - valid for every n < 2^64
+    return passes_all({2, 325, 9'375, 28'178, 450'775, 9'780'504, 1'795'265'022});
+}
+
+#endif // MILLER_RABIN_HPP
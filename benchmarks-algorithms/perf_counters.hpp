@@ -0,0 +1,223 @@
+#ifndef PERF_COUNTERS_HPP
+#define PERF_COUNTERS_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <cerrno>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define PERF_COUNTERS_HAS_PERF_EVENT 1
+#endif
+
+struct PerfCounterValue
+{
+    std::string name;
+    std::optional<double> value; // nullopt - the event is not supported by this CPU or kernel
+};
+
+// hardware and software counters of Linux perf_event_open - the calling thread and threads it spawns while counting;
+// system wide on every CPU (other processes included) only on request and when the kernel allows it
+// (perf_event_paranoid <= 0 or CAP_PERFMON), otherwise the thread scope is used;
+// when nothing can be opened (containers, other platforms) available() is false and error() tells why
+class PerfCounters
+{
+public:
+    enum class Scope
+    {
+        none,
+        system_wide,
+        calling_thread
+    };
+
+private:
+    struct Event
+    {
+        const char* name;
+        uint32_t type;
+        uint64_t config;
+        std::vector<int> fds; // one per CPU for the system wide scope
+    };
+
+    std::vector<Event> events_;
+    Scope scope_ = Scope::none;
+    std::string error_;
+
+public:
+    explicit PerfCounters(bool system_wide = false)
+    {
+#ifdef PERF_COUNTERS_HAS_PERF_EVENT
+        constexpr uint64_t l1d_read_miss = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+
+        events_ = {
+            {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, {}},
+            {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, {}},
+            {"L1d-misses", PERF_TYPE_HW_CACHE, l1d_read_miss, {}},
+            {"LLC-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, {}},
+            {"branch-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, {}},
+            {"context-switches", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES, {}}};
+
+        if (!(system_wide && open_all(Scope::system_wide)) && !open_all(Scope::calling_thread))
+            close_all();
+#else
+        error_ = "perf_event_open is available on Linux only";
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    ~PerfCounters()
+    {
+        close_all();
+    }
+
+    bool available() const noexcept
+    {
+        return scope_ != Scope::none;
+    }
+
+    Scope scope() const noexcept
+    {
+        return scope_;
+    }
+
+    const std::string& error() const noexcept
+    {
+        return error_;
+    }
+
+    void start() noexcept
+    {
+        for_each_fd([](int fd) {
+#ifdef PERF_COUNTERS_HAS_PERF_EVENT
+            ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+        });
+    }
+
+    void stop() noexcept
+    {
+        for_each_fd([](int fd) {
+#ifdef PERF_COUNTERS_HAS_PERF_EVENT
+            ::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+#endif
+        });
+    }
+
+    // counts since start() - scaled up when the kernel had to multiplex the counters
+    std::vector<PerfCounterValue> read() const
+    {
+        std::vector<PerfCounterValue> values;
+
+        for (const auto& event : events_)
+        {
+            std::optional<double> total;
+
+            for (int fd : event.fds)
+            {
+#ifdef PERF_COUNTERS_HAS_PERF_EVENT
+                uint64_t data[3] = {}; // value, time enabled, time running
+
+                if (fd >= 0 && ::read(fd, data, sizeof(data)) == sizeof(data))
+                {
+                    double value = data[2] > 0 ? static_cast<double>(data[0]) * data[1] / data[2] : 0.0;
+                    total = total.value_or(0.0) + value;
+                }
+#endif
+            }
+
+            values.push_back(PerfCounterValue{event.name, total});
+        }
+
+        return values;
+    }
+
+private:
+    template <typename F>
+    void for_each_fd(F f) const noexcept
+    {
+        for (const auto& event : events_)
+        {
+            for (int fd : event.fds)
+            {
+                if (fd >= 0)
+                    f(fd);
+            }
+        }
+    }
+
+    void close_all() noexcept
+    {
+        for_each_fd([](int fd) {
+#ifdef PERF_COUNTERS_HAS_PERF_EVENT
+            ::close(fd);
+#endif
+        });
+
+        for (auto& event : events_)
+            event.fds.clear();
+
+        scope_ = Scope::none;
+    }
+
+#ifdef PERF_COUNTERS_HAS_PERF_EVENT
+    static int open_event(const Event& event, pid_t pid, int cpu, bool inherit) noexcept
+    {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = event.type;
+        attr.config = event.config;
+        attr.disabled = 1;
+        attr.inherit = inherit;
+        attr.exclude_kernel = event.type != PERF_TYPE_SOFTWARE; // context switches happen in the kernel - excluded they always read 0
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        return static_cast<int>(::syscall(SYS_perf_event_open, &attr, pid, cpu, -1, 0));
+    }
+
+    // succeeds when at least one event opens - hardware events are often missing in virtual machines
+    bool open_all(Scope scope)
+    {
+        close_all();
+
+        const long no_of_cpus = scope == Scope::system_wide ? ::sysconf(_SC_NPROCESSORS_ONLN) : 1;
+        bool any_opened = false;
+
+        for (auto& event : events_)
+        {
+            for (long cpu = 0; cpu < no_of_cpus; ++cpu)
+            {
+                int fd = scope == Scope::system_wide
+                    ? open_event(event, -1, static_cast<int>(cpu), false)
+                    : open_event(event, 0, -1, true);
+
+                if (fd < 0)
+                    error_ = std::string{"perf_event_open failed: "} + std::strerror(errno);
+                else
+                    any_opened = true;
+
+                event.fds.push_back(fd);
+            }
+        }
+
+        if (!any_opened)
+            return false;
+
+        scope_ = scope;
+        error_.clear();
+        return true;
+    }
+#endif
+};
+
+#endif // PERF_COUNTERS_HPP
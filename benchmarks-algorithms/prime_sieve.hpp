@@ -0,0 +1,118 @@
+#ifndef PRIME_SIEVE_HPP
+#define PRIME_SIEVE_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// bit-packed sieve of Eratosthenes over odd numbers - bit i tells whether 2 * i + 1 is prime;
+// new ranges are sieved segment by segment, so the working set stays in L2 cache
+class PrimeSieve
+{
+    std::vector<uint64_t> bits_;
+    uint64_t limit_ = 0; // every number <= limit_ is classified
+    uint64_t slots_ = 0; // odd numbers classified so far - the first one is 1
+
+    static constexpr uint64_t segment_slots = 1 << 18;
+
+public:
+    explicit PrimeSieve(uint64_t limit = 0)
+    {
+        extend_to(limit);
+    }
+
+    uint64_t limit() const noexcept
+    {
+        return limit_;
+    }
+
+    // lookup only - safe to call concurrently, n must not exceed limit()
+    bool test(uint64_t n) const noexcept
+    {
+        assert(n <= limit_);
+
+        if (n % 2 == 0)
+            return n == 2;
+
+        uint64_t slot = n / 2;
+        return (bits_[slot / 64] >> (slot % 64)) & 1;
+    }
+
+    // grows the sieve when n is beyond the limit - not thread safe
+    bool is_prime(uint64_t n)
+    {
+        if (n > limit_)
+            extend_to(std::max(n, 2 * limit_));
+
+        return test(n);
+    }
+
+    bool operator()(uint64_t n) const noexcept
+    {
+        return test(n);
+    }
+
+    void extend_to(uint64_t new_limit)
+    {
+        if (new_limit <= limit_)
+            return;
+
+        const uint64_t root = isqrt(new_limit);
+        if (root > limit_ && root < new_limit)
+            extend_to(root); // base primes come from the sieve itself
+
+        std::vector<uint64_t> base_primes;
+        for (uint64_t p = 3; p <= root; p += 2)
+        {
+            if (test(p))
+                base_primes.push_back(p);
+        }
+
+        const uint64_t first_slot = slots_;
+        const uint64_t new_slots = (new_limit - 1) / 2 + 1;
+
+        bits_.resize((new_slots + 63) / 64, 0);
+        for (uint64_t slot = first_slot; slot < new_slots; ++slot)
+            bits_[slot / 64] |= uint64_t{1} << (slot % 64);
+
+        if (first_slot == 0)
+            bits_[0] &= ~uint64_t{1}; // 1 is not a prime
+
+        for (uint64_t segment_begin = first_slot; segment_begin < new_slots; segment_begin += segment_slots)
+        {
+            const uint64_t segment_end = std::min(segment_begin + segment_slots, new_slots);
+            const uint64_t first_number = 2 * segment_begin + 1;
+
+            for (uint64_t p : base_primes)
+            {
+                uint64_t multiple = std::max(p * p, (first_number + p - 1) / p * p);
+                if (multiple % 2 == 0)
+                    multiple += p;
+
+                for (uint64_t slot = multiple / 2; slot < segment_end; slot += p)
+                    bits_[slot / 64] &= ~(uint64_t{1} << (slot % 64));
+            }
+        }
+
+        slots_ = new_slots;
+        limit_ = new_limit;
+    }
+
+private:
+    static uint64_t isqrt(uint64_t n) noexcept
+    {
+        auto root = static_cast<uint64_t>(std::sqrt(static_cast<double>(n)));
+
+        while (root > 0 && root > n / root)
+            --root;
+        while ((root + 1) <= n / (root + 1))
+            ++root;
+
+        return root;
+    }
+};
+
+#endif // PRIME_SIEVE_HPP
@@ -0,0 +1,56 @@
+#ifndef PROCESS_MEMORY_HPP
+#define PROCESS_MEMORY_HPP
+
+#include <cstddef>
+#include <fstream>
+#include <optional>
+#include <string>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+// Linux only: values are read from /proc/self/status; other platforms get nullopt
+inline std::optional<size_t> read_proc_status_kb(const std::string& key)
+{
+    std::ifstream status{"/proc/self/status"};
+
+    std::string line;
+    while (std::getline(status, line))
+    {
+        if (line.compare(0, key.size(), key) == 0 && line.size() > key.size() && line[key.size()] == ':')
+            return std::stoull(line.substr(key.size() + 1));
+    }
+
+    return std::nullopt;
+}
+
+// peak resident set growth caused by a callable - the high water mark of the process
+// is reset before the call (Linux >= 4.0), so loaders measured one after another do not mask each other
+template <typename F>
+std::optional<size_t> peak_rss_growth_kb(F&& f)
+{
+#ifdef __GLIBC__
+    ::malloc_trim(0); // hand freed pages back, otherwise the heap left by a previous run hides the growth
+#endif
+
+    {
+        std::ofstream clear_refs{"/proc/self/clear_refs"};
+        if (!(clear_refs << "5" << std::flush))
+            return std::nullopt;
+    }
+
+    auto rss_before = read_proc_status_kb("VmRSS");
+
+    {
+        [[maybe_unused]] auto result = f(); // result stays alive while the peak is read
+        auto peak = read_proc_status_kb("VmHWM");
+
+        if (!rss_before || !peak)
+            return std::nullopt;
+
+        return *peak > *rss_before ? *peak - *rss_before : 0;
+    }
+}
+
+#endif // PROCESS_MEMORY_HPP
@@ -0,0 +1,236 @@
+#ifndef RADIX_SORT_HPP
+#define RADIX_SORT_HPP
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <numeric>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+enum class Case
+{
+    sensitive,
+    insensitive // ASCII letters are compared as lowercase - the order of boost::to_lower_copy(a) < boost::to_lower_copy(b)
+};
+
+namespace radix_sort_details
+{
+    struct Entry
+    {
+        const unsigned char* chars;
+        uint32_t length;
+        uint32_t index; // position of the word before sorting
+    };
+
+    // buckets below this size are sorted with multikey quicksort
+    constexpr size_t radix_threshold = 64;
+    // below this size multikey quicksort falls back to insertion sort
+    constexpr size_t insertion_threshold = 16;
+
+    // 0 marks the end of a word, so shorter words go first; bytes are compared as unsigned like in std::string
+    template <Case case_mode>
+    int char_at(const Entry& entry, size_t depth) noexcept
+    {
+        if (depth >= entry.length)
+            return 0;
+
+        if constexpr (case_mode == Case::insensitive)
+            return std::tolower(entry.chars[depth]) + 1;
+        else
+            return entry.chars[depth] + 1;
+    }
+
+    template <Case case_mode>
+    bool less_from(const Entry& a, const Entry& b, size_t depth) noexcept
+    {
+        for (;; ++depth)
+        {
+            int ca = char_at<case_mode>(a, depth);
+            int cb = char_at<case_mode>(b, depth);
+
+            if (ca != cb)
+                return ca < cb;
+
+            if (ca == 0)
+                return false;
+        }
+    }
+
+    template <Case case_mode>
+    void insertion_sort(Entry* first, Entry* last, size_t depth) noexcept
+    {
+        for (Entry* i = first + 1; i < last; ++i)
+        {
+            Entry value = *i;
+            Entry* j = i;
+
+            for (; j != first && less_from<case_mode>(value, *(j - 1), depth); --j)
+                *j = *(j - 1);
+
+            *j = value;
+        }
+    }
+
+    // Bentley & Sedgewick - three-way partition on a single character
+    template <Case case_mode>
+    void multikey_quicksort(Entry* first, Entry* last, size_t depth) noexcept
+    {
+        while (static_cast<size_t>(last - first) > insertion_threshold)
+        {
+            int a = char_at<case_mode>(*first, depth);
+            int b = char_at<case_mode>(first[(last - first) / 2], depth);
+            int c = char_at<case_mode>(*(last - 1), depth);
+            int pivot = std::max(std::min(a, b), std::min(std::max(a, b), c));
+
+            Entry* lt = first;
+            Entry* gt = last;
+
+            for (Entry* i = first; i < gt;)
+            {
+                int ch = char_at<case_mode>(*i, depth);
+
+                if (ch < pivot)
+                    std::swap(*lt++, *i++);
+                else if (ch > pivot)
+                    std::swap(*i, *--gt);
+                else
+                    ++i;
+            }
+
+            multikey_quicksort<case_mode>(first, lt, depth);
+            multikey_quicksort<case_mode>(gt, last, depth);
+
+            if (pivot == 0) // all words in the middle part have ended - they are equal
+                return;
+
+            first = lt;
+            last = gt;
+            ++depth;
+        }
+
+        insertion_sort<case_mode>(first, last, depth);
+    }
+
+    using Offsets = std::array<size_t, 258>;
+
+    // one counting sort pass on the character at depth - returns bucket boundaries
+    template <Case case_mode>
+    Offsets distribute(Entry* first, Entry* last, size_t depth, Entry* scratch) noexcept
+    {
+        std::array<size_t, 257> counts{};
+        for (Entry* it = first; it != last; ++it)
+            ++counts[char_at<case_mode>(*it, depth)];
+
+        Offsets offsets;
+        offsets[0] = 0;
+        std::partial_sum(counts.begin(), counts.end(), offsets.begin() + 1);
+
+        auto positions = offsets;
+        for (Entry* it = first; it != last; ++it)
+            scratch[positions[char_at<case_mode>(*it, depth)]++] = *it;
+
+        std::copy(scratch, scratch + (last - first), first);
+
+        return offsets;
+    }
+
+    template <Case case_mode>
+    void msd_radix_sort(Entry* first, Entry* last, size_t depth, Entry* scratch) noexcept
+    {
+        while (static_cast<size_t>(last - first) >= radix_threshold)
+        {
+            const size_t size = last - first;
+            const Offsets offsets = distribute<case_mode>(first, last, depth, scratch);
+
+            // common prefix - no need to recurse, just look at the next character
+            auto single_bucket = std::find(offsets.begin() + 1, offsets.end(), size);
+            if (*(single_bucket - 1) == 0)
+            {
+                if (single_bucket == offsets.begin() + 1) // all words have ended
+                    return;
+
+                ++depth;
+                continue;
+            }
+
+            for (size_t bucket = 1; bucket < 257; ++bucket) // bucket 0 holds equal words
+            {
+                if (offsets[bucket + 1] - offsets[bucket] > 1)
+                    msd_radix_sort<case_mode>(first + offsets[bucket], first + offsets[bucket + 1], depth + 1, scratch + offsets[bucket]);
+            }
+
+            return;
+        }
+
+        multikey_quicksort<case_mode>(first, last, depth);
+    }
+
+    template <Case case_mode, typename ExecutionPolicy>
+    void sort_entries(ExecutionPolicy&& policy, std::vector<Entry>& entries)
+    {
+        std::vector<Entry> scratch(entries.size());
+        Entry* first = entries.data();
+        Entry* last = entries.data() + entries.size();
+
+        if (entries.size() < radix_threshold)
+        {
+            multikey_quicksort<case_mode>(first, last, 0);
+            return;
+        }
+
+        // the first pass is done here, the buckets of the first character are sorted in parallel
+        const Offsets offsets = distribute<case_mode>(first, last, 0, scratch.data());
+
+        std::array<size_t, 256> buckets;
+        std::iota(buckets.begin(), buckets.end(), 1);
+
+        std::for_each(std::forward<ExecutionPolicy>(policy), buckets.begin(), buckets.end(), [&](size_t bucket) {
+            msd_radix_sort<case_mode>(first + offsets[bucket], first + offsets[bucket + 1], 1, scratch.data() + offsets[bucket]);
+        });
+    }
+} // namespace radix_sort_details
+
+// MSD radix sort of std::vector<std::string> or std::vector<std::string_view> - words are sorted
+// through (pointer, length, index) entries and moved into place at the end
+template <typename ExecutionPolicy, typename String, typename = std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>>>
+void radix_sort(ExecutionPolicy&& policy, std::vector<String>& words, Case case_mode = Case::sensitive)
+{
+    using namespace radix_sort_details;
+
+    if (words.size() > UINT32_MAX)
+        throw std::length_error("radix_sort - too many words");
+
+    std::vector<Entry> entries(words.size());
+    std::transform(policy, words.begin(), words.end(), entries.begin(), [first = words.data()](const String& word) {
+        std::string_view chars{word};
+
+        if (chars.size() > UINT32_MAX)
+            throw std::length_error("radix_sort - word too long");
+
+        return Entry{reinterpret_cast<const unsigned char*>(chars.data()), static_cast<uint32_t>(chars.size()), static_cast<uint32_t>(&word - first)};
+    });
+
+    if (case_mode == Case::insensitive)
+        sort_entries<Case::insensitive>(policy, entries);
+    else
+        sort_entries<Case::sensitive>(policy, entries);
+
+    std::vector<String> sorted_words(words.size());
+    std::transform(policy, entries.begin(), entries.end(), sorted_words.begin(), [&words](const Entry& entry) { return std::move(words[entry.index]); });
+    words = std::move(sorted_words);
+}
+
+template <typename String>
+void radix_sort(std::vector<String>& words, Case case_mode = Case::sensitive)
+{
+    radix_sort(std::execution::seq, words, case_mode);
+}
+
+#endif // RADIX_SORT_HPP
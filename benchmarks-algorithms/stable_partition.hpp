@@ -0,0 +1,149 @@
+#ifndef STABLE_PARTITION_HPP
+#define STABLE_PARTITION_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <execution>
+#include <iterator>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace stable_partition_details
+{
+    constexpr size_t block_size = 4096;
+
+    // 1. flags and true counts per block, 2. exclusive scan of the counts, 3. every block scatters its elements -
+    // the trues to their offset from the scan, the falses after all trues; the predicate is evaluated once per element
+    // and its results are left in flags
+    template <bool move_elements, typename ExecutionPolicy, typename RandomIt, typename OutIt, typename FlagIt, typename Predicate>
+    OutIt scatter_partition(ExecutionPolicy&& policy, RandomIt first, RandomIt last, OutIt out, FlagIt flags, Predicate& pred)
+    {
+        const size_t size = last - first;
+        if (size == 0)
+            return out;
+
+        const size_t no_of_blocks = (size + block_size - 1) / block_size;
+
+        std::vector<size_t> blocks(no_of_blocks);
+        std::iota(blocks.begin(), blocks.end(), size_t{0});
+
+        std::vector<size_t> true_counts(no_of_blocks);
+
+        std::for_each(policy, blocks.begin(), blocks.end(), [&](size_t block) {
+            const size_t block_first = block * block_size;
+            const size_t block_last = std::min(size, block_first + block_size);
+
+            size_t count = 0;
+            for (size_t i = block_first; i < block_last; ++i)
+            {
+                const bool flag = pred(first[i]);
+                flags[i] = flag;
+                count += flag;
+            }
+
+            true_counts[block] = count;
+        });
+
+        std::vector<size_t> true_offsets(no_of_blocks);
+        std::exclusive_scan(policy, true_counts.begin(), true_counts.end(), true_offsets.begin(), size_t{0});
+
+        const size_t no_of_trues = true_offsets.back() + true_counts.back();
+
+        std::for_each(policy, blocks.begin(), blocks.end(), [&](size_t block) {
+            const size_t block_first = block * block_size;
+            const size_t block_last = std::min(size, block_first + block_size);
+
+            size_t true_position = true_offsets[block];
+            size_t false_position = no_of_trues + (block_first - true_offsets[block]);
+
+            for (size_t i = block_first; i < block_last; ++i)
+            {
+                size_t& position = flags[i] ? true_position : false_position;
+
+                if constexpr (move_elements)
+                    out[position++] = std::move(first[i]);
+                else
+                    out[position++] = first[i];
+            }
+        });
+
+        return out + no_of_trues;
+    }
+} // namespace stable_partition_details
+
+// copies elements satisfying pred, then the others, to out keeping their relative order -
+// returns the partition point in the output
+template <typename ExecutionPolicy, typename RandomIt, typename OutIt, typename Predicate>
+OutIt parallel_stable_partition_copy(ExecutionPolicy&& policy, RandomIt first, RandomIt last, OutIt out, Predicate pred)
+{
+    std::vector<unsigned char> flags(last - first);
+    return stable_partition_details::scatter_partition<false>(policy, first, last, out, flags.begin(), pred);
+}
+
+// fused classify and partition - pred is evaluated once per element, its results are written to flags_out
+// (flags_out[i] for first[i]) and the elements, stably partitioned, to out - returns the partition point in out
+template <typename ExecutionPolicy, typename RandomIt, typename FlagIt, typename OutIt, typename Predicate>
+OutIt parallel_classify_partition_copy(ExecutionPolicy&& policy, RandomIt first, RandomIt last, FlagIt flags_out, OutIt out, Predicate pred)
+{
+    return stable_partition_details::scatter_partition<false>(policy, first, last, out, flags_out, pred);
+}
+
+// in place variant - windows of scratch_size elements are partitioned through a scratch buffer of that size and
+// joined with std::rotate as they are produced, like a binary counter: a window is joined with the segment
+// on top of the stack while both cover the same number of windows, so the stack holds at most
+// log2(size / scratch_size) + 1 segments - extra memory is O(scratch_size), the rotates move O(n log(n / scratch_size))
+template <typename ExecutionPolicy, typename RandomIt, typename Predicate>
+RandomIt parallel_stable_partition(ExecutionPolicy&& policy, RandomIt first, RandomIt last, Predicate pred, size_t scratch_size = 1 << 16)
+{
+    using ValueType = typename std::iterator_traits<RandomIt>::value_type;
+
+    const size_t size = last - first;
+    if (size == 0)
+        return first;
+
+    scratch_size = std::clamp<size_t>(scratch_size, 1, size);
+    std::vector<ValueType> scratch(scratch_size);
+    std::vector<unsigned char> flags(scratch_size);
+
+    struct Segment
+    {
+        RandomIt first;
+        RandomIt middle; // partition point
+        RandomIt last;
+        size_t level;    // the segment covers 2^level windows
+    };
+
+    // [T1 F1][T2 F2] -> [T1 T2 F1 F2]
+    auto join = [&policy](const Segment& left, const Segment& right) {
+        return Segment{left.first, std::rotate(policy, left.middle, right.first, right.middle), right.last, left.level + 1};
+    };
+
+    std::vector<Segment> segments; // levels strictly decreasing from the bottom
+
+    for (size_t window_first = 0; window_first < size; window_first += scratch_size)
+    {
+        const size_t window_last = std::min(size, window_first + scratch_size);
+
+        auto scratch_middle = stable_partition_details::scatter_partition<true>(policy, first + window_first, first + window_last, scratch.begin(), flags.begin(), pred);
+        std::move(policy, scratch.begin(), scratch.begin() + (window_last - window_first), first + window_first);
+
+        Segment segment{first + window_first, first + window_first + (scratch_middle - scratch.begin()), first + window_last, 0};
+
+        for (; !segments.empty() && segments.back().level == segment.level; segments.pop_back())
+            segment = join(segments.back(), segment);
+
+        segments.push_back(segment);
+    }
+
+    while (segments.size() > 1)
+    {
+        Segment right = segments.back();
+        segments.pop_back();
+        segments.back() = join(segments.back(), right);
+    }
+
+    return segments.front().middle;
+}
+
+#endif // STABLE_PARTITION_HPP
@@ -0,0 +1,154 @@
+#ifndef STRING_HASH_HPP
+#define STRING_HASH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string_view>
+
+#if defined(_MSC_VER) && !defined(__SIZEOF_INT128__)
+#include <intrin.h>
+#endif
+
+// hashers for std::string_view - every one has a name used in the benchmark reports
+
+struct StdHash
+{
+    static constexpr const char* name = "std::hash";
+
+    size_t operator()(std::string_view text) const noexcept
+    {
+        return std::hash<std::string_view>{}(text);
+    }
+};
+
+// byte at a time - the classic baseline
+struct Fnv1aHash
+{
+    static constexpr const char* name = "FNV-1a";
+
+    size_t operator()(std::string_view text) const noexcept
+    {
+        uint64_t hash = 0xcbf29ce484222325ULL;
+
+        for (unsigned char c : text)
+        {
+            hash ^= c;
+            hash *= 0x100000001b3ULL;
+        }
+
+        return static_cast<size_t>(hash);
+    }
+};
+
+namespace string_hash_details
+{
+    // unaligned little-endian reads - memcpy compiles to a single load
+    inline uint64_t read8(const unsigned char* p) noexcept
+    {
+        uint64_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    inline uint64_t read4(const unsigned char* p) noexcept
+    {
+        uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    // 1..3 bytes
+    inline uint64_t read3(const unsigned char* p, size_t k) noexcept
+    {
+        return (uint64_t{p[0]} << 16) | (uint64_t{p[k >> 1]} << 8) | p[k - 1];
+    }
+
+    // 64 x 64 -> 128 bit multiplication, the halves are returned in a and b
+    inline void multiply(uint64_t& a, uint64_t& b) noexcept
+    {
+#ifdef __SIZEOF_INT128__
+        unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+        a = static_cast<uint64_t>(r);
+        b = static_cast<uint64_t>(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        a = _umul128(a, b, &b);
+#else
+        uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<uint32_t>(a), lb = static_cast<uint32_t>(b);
+        uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+        uint64_t t = rl + (rm0 << 32);
+        uint64_t c = t < rl;
+        uint64_t lo = t + (rm1 << 32);
+        c += lo < t;
+        a = lo;
+        b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+    }
+
+    inline uint64_t mix(uint64_t a, uint64_t b) noexcept
+    {
+        multiply(a, b);
+        return a ^ b;
+    }
+} // namespace string_hash_details
+
+// wyhash-style hash - short keys are folded from at most four overlapping reads,
+// longer ones are consumed in 16-byte blocks with one 128-bit multiplication per block
+struct WyHash
+{
+    static constexpr const char* name = "wyhash";
+
+    uint64_t seed = 0;
+
+    size_t operator()(std::string_view text) const noexcept
+    {
+        using namespace string_hash_details;
+
+        constexpr uint64_t secret[] = {0xa0761d6478bd642fULL, 0xe7037ed1a0b428dbULL, 0x8ebc6af09c88c6e3ULL, 0x589965cc75374cc3ULL};
+
+        const auto* p = reinterpret_cast<const unsigned char*>(text.data());
+        const size_t length = text.size();
+
+        uint64_t state = seed ^ mix(seed ^ secret[0], secret[1]);
+        uint64_t a, b;
+
+        if (length <= 16)
+        {
+            if (length >= 4)
+            {
+                const size_t shift = (length >> 3) << 2;
+                a = (read4(p) << 32) | read4(p + shift);
+                b = (read4(p + length - 4) << 32) | read4(p + length - 4 - shift);
+            }
+            else if (length > 0)
+            {
+                a = read3(p, length);
+                b = 0;
+            }
+            else
+            {
+                a = b = 0;
+            }
+        }
+        else
+        {
+            size_t remaining = length;
+
+            for (; remaining > 16; remaining -= 16, p += 16)
+                state = mix(read8(p) ^ secret[1], read8(p + 8) ^ state);
+
+            // the last 16 bytes overlap the last block
+            a = read8(p + remaining - 16);
+            b = read8(p + remaining - 8);
+        }
+
+        a ^= secret[1];
+        b ^= state;
+        multiply(a, b);
+
+        return static_cast<size_t>(mix(a ^ secret[0] ^ length, b ^ secret[1]));
+    }
+};
+
+#endif // STRING_HASH_HPP
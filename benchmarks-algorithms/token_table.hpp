@@ -0,0 +1,241 @@
+#ifndef TOKEN_TABLE_HPP
+#define TOKEN_TABLE_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <iterator>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// struct-of-arrays container of words - all characters live in one contiguous buffer,
+// tokens are (offset, length) entries pointing into it and are handed out as std::string_view
+class TokenTable
+{
+    struct Token
+    {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    std::vector<char> chars_;
+    std::vector<Token> tokens_;
+
+public:
+    using value_type = std::string_view;
+    using size_type = size_t;
+
+    class const_iterator
+    {
+        const char* chars_ = nullptr;
+        const Token* token_ = nullptr;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::string_view; // elements are created on the fly
+        using pointer = void;
+
+        const_iterator() = default;
+
+        const_iterator(const char* chars, const Token* token) noexcept
+            : chars_{chars}, token_{token}
+        {
+        }
+
+        std::string_view operator*() const noexcept
+        {
+            return {chars_ + token_->offset, token_->length};
+        }
+
+        std::string_view operator[](difference_type n) const noexcept
+        {
+            return *(*this + n);
+        }
+
+        const_iterator& operator++() noexcept
+        {
+            ++token_;
+            return *this;
+        }
+
+        const_iterator operator++(int) noexcept
+        {
+            auto it = *this;
+            ++token_;
+            return it;
+        }
+
+        const_iterator& operator--() noexcept
+        {
+            --token_;
+            return *this;
+        }
+
+        const_iterator operator--(int) noexcept
+        {
+            auto it = *this;
+            --token_;
+            return it;
+        }
+
+        const_iterator& operator+=(difference_type n) noexcept
+        {
+            token_ += n;
+            return *this;
+        }
+
+        const_iterator& operator-=(difference_type n) noexcept
+        {
+            token_ -= n;
+            return *this;
+        }
+
+        friend const_iterator operator+(const_iterator it, difference_type n) noexcept
+        {
+            return it += n;
+        }
+
+        friend const_iterator operator+(difference_type n, const_iterator it) noexcept
+        {
+            return it += n;
+        }
+
+        friend const_iterator operator-(const_iterator it, difference_type n) noexcept
+        {
+            return it -= n;
+        }
+
+        friend difference_type operator-(const const_iterator& a, const const_iterator& b) noexcept
+        {
+            return a.token_ - b.token_;
+        }
+
+        friend bool operator==(const const_iterator& a, const const_iterator& b) noexcept
+        {
+            return a.token_ == b.token_;
+        }
+
+        friend bool operator!=(const const_iterator& a, const const_iterator& b) noexcept
+        {
+            return a.token_ != b.token_;
+        }
+
+        friend bool operator<(const const_iterator& a, const const_iterator& b) noexcept
+        {
+            return a.token_ < b.token_;
+        }
+
+        friend bool operator>(const const_iterator& a, const const_iterator& b) noexcept
+        {
+            return a.token_ > b.token_;
+        }
+
+        friend bool operator<=(const const_iterator& a, const const_iterator& b) noexcept
+        {
+            return a.token_ <= b.token_;
+        }
+
+        friend bool operator>=(const const_iterator& a, const const_iterator& b) noexcept
+        {
+            return a.token_ >= b.token_;
+        }
+    };
+
+    using iterator = const_iterator;
+
+    TokenTable() = default;
+
+    template <typename InputIt>
+    TokenTable(InputIt first, InputIt last)
+    {
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<InputIt>::iterator_category>)
+        {
+            size_t no_of_chars = 0;
+            for (auto it = first; it != last; ++it)
+                no_of_chars += std::string_view{*it}.size();
+
+            reserve(std::distance(first, last), no_of_chars);
+        }
+
+        for (; first != last; ++first)
+            push_back(*first);
+    }
+
+    void reserve(size_t no_of_tokens, size_t no_of_chars)
+    {
+        tokens_.reserve(no_of_tokens);
+        chars_.reserve(no_of_chars);
+    }
+
+    void push_back(std::string_view token)
+    {
+        if (chars_.size() + token.size() > UINT32_MAX)
+            throw std::length_error("TokenTable - character buffer exceeds 4 GB");
+
+        tokens_.push_back(Token{static_cast<uint32_t>(chars_.size()), static_cast<uint32_t>(token.size())});
+        chars_.insert(chars_.end(), token.begin(), token.end());
+    }
+
+    std::string_view operator[](size_t index) const noexcept
+    {
+        assert(index < tokens_.size());
+        return {chars_.data() + tokens_[index].offset, tokens_[index].length};
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return {chars_.data(), tokens_.data()};
+    }
+
+    const_iterator end() const noexcept
+    {
+        return {chars_.data(), tokens_.data() + tokens_.size()};
+    }
+
+    size_t size() const noexcept
+    {
+        return tokens_.size();
+    }
+
+    bool empty() const noexcept
+    {
+        return tokens_.empty();
+    }
+
+    // whole character buffer - tokens are stored back to back without separators
+    std::string_view chars() const noexcept
+    {
+        return {chars_.data(), chars_.size()};
+    }
+
+    // reorders the (offset, length) entries only - characters stay where they are
+    template <typename Compare>
+    void sort(Compare comp)
+    {
+        std::sort(tokens_.begin(), tokens_.end(), token_compare(comp));
+    }
+
+    template <typename ExecutionPolicy, typename Compare>
+    void sort(ExecutionPolicy&& policy, Compare comp)
+    {
+        std::sort(std::forward<ExecutionPolicy>(policy), tokens_.begin(), tokens_.end(), token_compare(comp));
+    }
+
+private:
+    template <typename Compare>
+    auto token_compare(Compare comp) const
+    {
+        return [chars = chars_.data(), comp](const Token& a, const Token& b) {
+            return comp(std::string_view{chars + a.offset, a.length}, std::string_view{chars + b.offset, b.length});
+        };
+    }
+};
+
+#endif // TOKEN_TABLE_HPP
@@ -0,0 +1,162 @@
+#ifndef WORD_COUNT_HPP
+#define WORD_COUNT_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// word -> number of occurrences - the keys are views into the corpus, which has to outlive the table
+template <typename Hash = std::hash<std::string_view>>
+using WordCounts = std::unordered_map<std::string_view, size_t, Hash>;
+
+namespace word_count_details
+{
+    // calls f(first, last) for no_of_threads equal ranges of words - the first range on the calling thread
+    template <typename Words, typename F>
+    void for_each_chunk(const Words& words, size_t no_of_threads, F f)
+    {
+        const size_t size = std::size(words);
+        no_of_threads = std::clamp<size_t>(no_of_threads, 1, std::max<size_t>(size, 1));
+
+        auto chunk = [&](size_t i) {
+            f(std::begin(words) + i * size / no_of_threads, std::begin(words) + (i + 1) * size / no_of_threads, i);
+        };
+
+        std::vector<std::future<void>> chunks;
+        chunks.reserve(no_of_threads - 1);
+
+        for (size_t i = 1; i < no_of_threads; ++i)
+            chunks.push_back(std::async(std::launch::async, chunk, i));
+
+        chunk(0);
+
+        for (auto& c : chunks)
+            c.get();
+    }
+} // namespace word_count_details
+
+// single threaded baseline
+template <typename Hash = std::hash<std::string_view>, typename Words>
+WordCounts<Hash> count_words(const Words& words)
+{
+    WordCounts<Hash> counts;
+
+    for (std::string_view word : words)
+        ++counts[word];
+
+    return counts;
+}
+
+// every thread counts its range of words into a local map - the maps are merged into the largest one at the end
+template <typename Hash = std::hash<std::string_view>, typename Words>
+WordCounts<Hash> count_words_local_maps(const Words& words, size_t no_of_threads)
+{
+    std::vector<WordCounts<Hash>> local_counts(std::clamp<size_t>(no_of_threads, 1, std::max<size_t>(std::size(words), 1)));
+
+    word_count_details::for_each_chunk(words, no_of_threads, [&](auto first, auto last, size_t thread_index) {
+        auto& counts = local_counts[thread_index];
+
+        for (; first != last; ++first)
+            ++counts[std::string_view{*first}];
+    });
+
+    auto largest = std::max_element(local_counts.begin(), local_counts.end(), [](const auto& a, const auto& b) { return a.size() < b.size(); });
+    WordCounts<Hash> counts = std::move(*largest);
+
+    for (auto& local : local_counts)
+    {
+        if (&local == &*largest) // moved from - its content is unspecified
+            continue;
+
+        for (const auto& [word, count] : local)
+            counts[word] += count;
+    }
+
+    return counts;
+}
+
+// one shared table split into shards by hash, each guarded by its own mutex - threads lock a shard per word
+template <typename Hash = std::hash<std::string_view>>
+class ShardedWordCounts
+{
+    struct alignas(64) Shard // no false sharing between neighbouring mutexes
+    {
+        std::mutex mtx;
+        WordCounts<Hash> counts;
+    };
+
+    std::vector<Shard> shards_;
+    Hash hash_;
+
+public:
+    explicit ShardedWordCounts(size_t no_of_shards = 64)
+        : shards_(std::max<size_t>(no_of_shards, 1))
+    {
+    }
+
+    void add(std::string_view word, size_t count = 1)
+    {
+        auto& shard = shards_[shard_index(word)];
+
+        std::lock_guard lk{shard.mtx};
+        shard.counts[word] += count;
+    }
+
+    size_t count(std::string_view word)
+    {
+        auto& shard = shards_[shard_index(word)];
+
+        std::lock_guard lk{shard.mtx};
+        auto it = shard.counts.find(word);
+        return it != shard.counts.end() ? it->second : 0;
+    }
+
+    // the shards hold disjoint sets of words, so no counts have to be added up
+    WordCounts<Hash> merge()
+    {
+        WordCounts<Hash> counts;
+
+        size_t size = 0;
+        for (auto& shard : shards_)
+            size += shard.counts.size();
+        counts.reserve(size);
+
+        for (auto& shard : shards_)
+        {
+            std::lock_guard lk{shard.mtx};
+            counts.insert(shard.counts.begin(), shard.counts.end());
+        }
+
+        return counts;
+    }
+
+private:
+    // the low bits select the bucket inside the shard, so the shard is taken from the high half of the hash -
+    // half of its width, so the shift is defined for a 32-bit size_t as well
+    size_t shard_index(std::string_view word) const
+    {
+        return (hash_(word) >> (std::numeric_limits<size_t>::digits / 2)) % shards_.size();
+    }
+};
+
+template <typename Hash = std::hash<std::string_view>, typename Words>
+WordCounts<Hash> count_words_sharded(const Words& words, size_t no_of_threads, size_t no_of_shards = 64)
+{
+    ShardedWordCounts<Hash> shared_counts{no_of_shards};
+
+    word_count_details::for_each_chunk(words, no_of_threads, [&](auto first, auto last, size_t) {
+        for (; first != last; ++first)
+            shared_counts.add(std::string_view{*first});
+    });
+
+    return shared_counts.merge();
+}
+
+#endif // WORD_COUNT_HPP
@@ -0,0 +1,633 @@
+#ifndef WORK_STEALING_POOL_HPP
+#define WORK_STEALING_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class WorkStealingPool;
+
+namespace work_stealing_details
+{
+    // the pool and worker index of the calling thread - pool is nullptr outside of any pool
+    struct CurrentWorker
+    {
+        WorkStealingPool* pool = nullptr;
+        size_t index = 0;
+    };
+
+    inline thread_local CurrentWorker current_worker;
+
+    struct Task
+    {
+        std::atomic<bool> done{false};
+        std::exception_ptr error;
+        bool is_root = false; // submitted by run() - an external thread waits for it
+
+        virtual ~Task() = default;
+
+        // must not touch the task after done is set - the owner may destroy it right away
+        void execute() noexcept
+        {
+            try
+            {
+                do_execute();
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            done.store(true, std::memory_order_release);
+        }
+
+    protected:
+        virtual void do_execute() = 0;
+    };
+
+    template <typename F>
+    struct FunctionTask : Task
+    {
+        F& f;
+
+        explicit FunctionTask(F& f)
+            : f{f}
+        {
+        }
+
+    protected:
+        void do_execute() override
+        {
+            f();
+        }
+    };
+
+    // Chase-Lev deque (Le, Pop, Cohen, Zappa Nardelli - "Correct and Efficient Work-Stealing for Weak Memory Models");
+    // the owner pushes and pops at the bottom, thieves steal from the top
+    class WorkStealingDeque
+    {
+        struct Buffer
+        {
+            size_t mask;
+            std::unique_ptr<std::atomic<Task*>[]> slots;
+
+            explicit Buffer(size_t capacity)
+                : mask{capacity - 1}, slots{new std::atomic<Task*>[capacity]}
+            {
+            }
+
+            size_t capacity() const noexcept
+            {
+                return mask + 1;
+            }
+
+            Task* get(int64_t index) const noexcept
+            {
+                return slots[static_cast<size_t>(index) & mask].load(std::memory_order_relaxed);
+            }
+
+            void put(int64_t index, Task* task) noexcept
+            {
+                slots[static_cast<size_t>(index) & mask].store(task, std::memory_order_relaxed);
+            }
+        };
+
+        alignas(64) std::atomic<int64_t> top_{0};
+        alignas(64) std::atomic<int64_t> bottom_{0};
+        std::atomic<Buffer*> buffer_;
+        std::vector<std::unique_ptr<Buffer>> buffers_; // old buffers stay alive - a thief may still read them
+
+    public:
+        explicit WorkStealingDeque(size_t capacity = 256)
+        {
+            buffers_.push_back(std::make_unique<Buffer>(capacity));
+            buffer_.store(buffers_.back().get(), std::memory_order_relaxed);
+        }
+
+        // owner only
+        void push(Task* task)
+        {
+            int64_t b = bottom_.load(std::memory_order_relaxed);
+            int64_t t = top_.load(std::memory_order_acquire);
+            Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+
+            if (b - t > static_cast<int64_t>(buffer->capacity()) - 1)
+                buffer = grow(buffer, t, b);
+
+            buffer->put(b, task);
+            std::atomic_thread_fence(std::memory_order_release);
+            bottom_.store(b + 1, std::memory_order_relaxed);
+        }
+
+        // owner only
+        Task* pop() noexcept
+        {
+            int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+            Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+            bottom_.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t t = top_.load(std::memory_order_relaxed);
+
+            if (t > b) // empty
+            {
+                bottom_.store(b + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            Task* task = buffer->get(b);
+
+            if (t == b) // the last task - race against thieves
+            {
+                if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    task = nullptr;
+
+                bottom_.store(b + 1, std::memory_order_relaxed);
+            }
+
+            return task;
+        }
+
+        // any thread
+        Task* steal() noexcept
+        {
+            int64_t t = top_.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t b = bottom_.load(std::memory_order_acquire);
+
+            if (t >= b)
+                return nullptr;
+
+            Task* task = buffer_.load(std::memory_order_acquire)->get(t);
+
+            if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                return nullptr; // lost the race
+
+            return task;
+        }
+
+    private:
+        Buffer* grow(Buffer* old_buffer, int64_t t, int64_t b)
+        {
+            auto new_buffer = std::make_unique<Buffer>(2 * old_buffer->capacity());
+
+            for (int64_t i = t; i < b; ++i)
+                new_buffer->put(i, old_buffer->get(i));
+
+            buffers_.push_back(std::move(new_buffer));
+            buffer_.store(buffers_.back().get(), std::memory_order_release);
+
+            return buffers_.back().get();
+        }
+    };
+} // namespace work_stealing_details
+
+// fork-join pool - every worker owns a Chase-Lev deque, idle workers steal from randomly chosen victims;
+// workers spin while a run() is in progress and sleep otherwise
+class WorkStealingPool
+{
+    using Task = work_stealing_details::Task;
+
+    struct Worker
+    {
+        work_stealing_details::WorkStealingDeque deque;
+        uint64_t rng_state;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+
+    std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable done_cv_;
+    std::deque<Task*> injected_;
+    std::atomic<size_t> no_of_injected_{0};
+    std::atomic<size_t> active_jobs_{0};
+    bool stop_ = false;
+
+public:
+    explicit WorkStealingPool(size_t no_of_threads = std::thread::hardware_concurrency())
+    {
+        no_of_threads = std::max<size_t>(no_of_threads, 1);
+
+        for (size_t i = 0; i < no_of_threads; ++i)
+        {
+            workers_.push_back(std::make_unique<Worker>());
+            workers_.back()->rng_state = 0x9E3779B97F4A7C15ULL * (i + 1);
+        }
+
+        for (size_t i = 0; i < no_of_threads; ++i)
+            threads_.emplace_back([this, i] { worker_loop(i); });
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    ~WorkStealingPool()
+    {
+        {
+            std::lock_guard lk{mutex_};
+            stop_ = true;
+        }
+
+        work_cv_.notify_all();
+
+        for (auto& thread : threads_)
+            thread.join();
+    }
+
+    size_t size() const noexcept
+    {
+        return workers_.size();
+    }
+
+    // runs f on a worker and waits for it - nested calls from the pool's own workers run f in place
+    template <typename F>
+    void run(F&& f)
+    {
+        if (work_stealing_details::current_worker.pool == this)
+        {
+            f();
+            return;
+        }
+
+        work_stealing_details::FunctionTask<F> task{f};
+        task.is_root = true;
+
+        {
+            std::lock_guard lk{mutex_};
+            injected_.push_back(&task);
+            no_of_injected_.fetch_add(1, std::memory_order_release);
+            active_jobs_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        work_cv_.notify_all();
+
+        {
+            std::unique_lock lk{mutex_};
+            done_cv_.wait(lk, [&task] { return task.done.load(std::memory_order_acquire); });
+            active_jobs_.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        if (task.error)
+            std::rethrow_exception(task.error);
+    }
+
+    // runs f1 and f2 possibly in parallel - f2 is exposed to thieves while the calling worker runs f1
+    template <typename F1, typename F2>
+    void invoke(F1&& f1, F2&& f2)
+    {
+        if (work_stealing_details::current_worker.pool != this)
+        {
+            run([&] { invoke(f1, f2); });
+            return;
+        }
+
+        const size_t index = work_stealing_details::current_worker.index;
+        Worker& worker = *workers_[index];
+
+        work_stealing_details::FunctionTask<F2> task2{f2};
+        worker.deque.push(&task2);
+
+        std::exception_ptr error1;
+        try
+        {
+            f1();
+        }
+        catch (...)
+        {
+            error1 = std::current_exception();
+        }
+
+        // everything f1 pushed has been joined, so task2 is at the bottom unless it was stolen
+        if (Task* task = worker.deque.pop())
+        {
+            assert(task == &task2);
+            task->execute();
+        }
+        else
+        {
+            while (!task2.done.load(std::memory_order_acquire))
+            {
+                if (Task* other = steal_from_others(index))
+                    other->execute();
+                else
+                    std::this_thread::yield();
+            }
+        }
+
+        if (error1)
+            std::rethrow_exception(error1);
+        if (task2.error)
+            std::rethrow_exception(task2.error);
+    }
+
+private:
+    Task* steal_from_others(size_t thief) noexcept
+    {
+        const size_t no_of_workers = workers_.size();
+        if (no_of_workers < 2)
+            return nullptr;
+
+        // xorshift64 - the first victim is random, then the others in order
+        uint64_t& x = workers_[thief]->rng_state;
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+
+        const size_t start = static_cast<size_t>(x % no_of_workers);
+
+        for (size_t i = 0; i < no_of_workers; ++i)
+        {
+            size_t victim = (start + i) % no_of_workers;
+
+            if (victim == thief)
+                continue;
+
+            if (Task* task = workers_[victim]->deque.steal())
+                return task;
+        }
+
+        return nullptr;
+    }
+
+    Task* take_injected()
+    {
+        if (no_of_injected_.load(std::memory_order_acquire) == 0)
+            return nullptr;
+
+        std::lock_guard lk{mutex_};
+
+        if (injected_.empty())
+            return nullptr;
+
+        Task* task = injected_.front();
+        injected_.pop_front();
+        no_of_injected_.fetch_sub(1, std::memory_order_relaxed);
+
+        return task;
+    }
+
+    void worker_loop(size_t index)
+    {
+        work_stealing_details::current_worker = work_stealing_details::CurrentWorker{this, index};
+
+        while (true)
+        {
+            Task* task = workers_[index]->deque.pop();
+
+            if (!task)
+                task = steal_from_others(index);
+
+            if (!task)
+                task = take_injected();
+
+            if (task)
+            {
+                const bool is_root = task->is_root;
+                task->execute();
+
+                if (is_root)
+                {
+                    std::lock_guard lk{mutex_};
+                    done_cv_.notify_all();
+                }
+
+                continue;
+            }
+
+            if (active_jobs_.load(std::memory_order_relaxed) > 0)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            std::unique_lock lk{mutex_};
+            work_cv_.wait(lk, [this] { return stop_ || active_jobs_.load(std::memory_order_relaxed) > 0; });
+
+            if (stop_ && active_jobs_.load(std::memory_order_relaxed) == 0)
+                return;
+        }
+    }
+};
+
+namespace work_stealing_details
+{
+    template <typename Size>
+    Size default_grain(const WorkStealingPool& pool, Size size)
+    {
+        return std::max<Size>(1, size / static_cast<Size>(8 * pool.size()));
+    }
+
+    template <typename Size, typename F>
+    void for_range(WorkStealingPool& pool, Size first, Size last, Size grain, F& f)
+    {
+        if (last - first <= grain)
+        {
+            f(first, last);
+            return;
+        }
+
+        Size middle = first + (last - first) / 2;
+        pool.invoke([&] { for_range(pool, first, middle, grain, f); }, [&] { for_range(pool, middle, last, grain, f); });
+    }
+
+    // reduction of a non-empty range - the init value of transform_reduce is folded in only once, at the end
+    template <typename T, typename RandomIt, typename Reduce, typename Transform>
+    T transform_reduce_range(WorkStealingPool& pool, RandomIt first, RandomIt last, Reduce& reduce, Transform& transform, ptrdiff_t grain)
+    {
+        if (last - first <= grain)
+        {
+            T result = transform(*first);
+            for (++first; first != last; ++first)
+                result = reduce(std::move(result), transform(*first));
+
+            return result;
+        }
+
+        RandomIt middle = first + (last - first) / 2;
+        std::optional<T> left, right;
+        pool.invoke(
+            [&] { left = transform_reduce_range<T>(pool, first, middle, reduce, transform, grain); },
+            [&] { right = transform_reduce_range<T>(pool, middle, last, reduce, transform, grain); });
+
+        return reduce(std::move(*left), std::move(*right));
+    }
+
+    // moves the merged ranges into out
+    template <typename RandomIt, typename OutIt, typename Compare>
+    void merge_into(WorkStealingPool& pool, RandomIt first1, RandomIt last1, RandomIt first2, RandomIt last2, OutIt out, Compare& comp, ptrdiff_t grain)
+    {
+        // at most 2 elements - the split below would not shrink both halves (middle1 == first1)
+        if ((last1 - first1) + (last2 - first2) <= std::max<ptrdiff_t>(grain, 2))
+        {
+            std::merge(std::make_move_iterator(first1), std::make_move_iterator(last1), std::make_move_iterator(first2), std::make_move_iterator(last2), out, comp);
+            return;
+        }
+
+        if (last1 - first1 < last2 - first2)
+        {
+            merge_into(pool, first2, last2, first1, last1, out, comp, grain);
+            return;
+        }
+
+        // split the longer range in half and the other one at the same value
+        RandomIt middle1 = first1 + (last1 - first1) / 2;
+        RandomIt middle2 = std::lower_bound(first2, last2, *middle1, comp);
+        OutIt out_middle = out + (middle1 - first1) + (middle2 - first2);
+
+        pool.invoke(
+            [&] { merge_into(pool, first1, middle1, first2, middle2, out, comp, grain); },
+            [&] { merge_into(pool, middle1, last1, middle2, last2, out_middle, comp, grain); });
+    }
+
+    template <typename RandomIt, typename BufferIt, typename Compare>
+    void merge_sort(WorkStealingPool& pool, RandomIt first, RandomIt last, BufferIt buffer, Compare& comp, ptrdiff_t grain)
+    {
+        if (last - first <= grain)
+        {
+            std::sort(first, last, comp);
+            return;
+        }
+
+        RandomIt middle = first + (last - first) / 2;
+        pool.invoke(
+            [&] { merge_sort(pool, first, middle, buffer, comp, grain); },
+            [&] { merge_sort(pool, middle, last, buffer + (middle - first), comp, grain); });
+
+        merge_into(pool, first, middle, middle, last, buffer, comp, grain);
+
+        auto move_back = [&](ptrdiff_t from, ptrdiff_t to) { std::move(buffer + from, buffer + to, first + from); };
+        for_range(pool, ptrdiff_t{0}, last - first, grain, move_back);
+    }
+} // namespace work_stealing_details
+
+// f(i) for every i in [first, last)
+template <typename Size, typename F>
+void parallel_for(WorkStealingPool& pool, Size first, Size last, F f, Size grain = 0)
+{
+    if (first >= last)
+        return;
+
+    if (grain == 0)
+        grain = work_stealing_details::default_grain(pool, last - first);
+
+    auto body = [&f](Size chunk_first, Size chunk_last) {
+        for (Size i = chunk_first; i != chunk_last; ++i)
+            f(i);
+    };
+
+    pool.run([&] { work_stealing_details::for_range(pool, first, last, grain, body); });
+}
+
+template <typename RandomIt, typename T, typename Reduce, typename Transform>
+T parallel_transform_reduce(WorkStealingPool& pool, RandomIt first, RandomIt last, T init, Reduce reduce, Transform transform, ptrdiff_t grain = 0)
+{
+    if (first == last)
+        return init;
+
+    if (grain == 0)
+        grain = work_stealing_details::default_grain(pool, last - first);
+
+    pool.run([&] { init = reduce(std::move(init), work_stealing_details::transform_reduce_range<T>(pool, first, last, reduce, transform, grain)); });
+
+    return init;
+}
+
+// parallel merge sort - needs a buffer of default constructible elements as big as the range
+template <typename RandomIt, typename Compare = std::less<>>
+void parallel_sort(WorkStealingPool& pool, RandomIt first, RandomIt last, Compare comp = {}, ptrdiff_t grain = 0)
+{
+    using ValueType = typename std::iterator_traits<RandomIt>::value_type;
+
+    const ptrdiff_t size = last - first;
+    if (size < 2)
+        return;
+
+    if (grain == 0)
+        grain = std::max<ptrdiff_t>(work_stealing_details::default_grain(pool, size), 2048);
+
+    std::vector<ValueType> buffer(size);
+    pool.run([&] { work_stealing_details::merge_sort(pool, first, last, buffer.begin(), comp, grain); });
+}
+
+// unstable, in place - chunks are partitioned in parallel, then the misplaced elements of all chunks
+// (false ones before the partition point, true ones after it) are swapped pairwise in parallel
+template <typename RandomIt, typename Predicate>
+RandomIt parallel_partition(WorkStealingPool& pool, RandomIt first, RandomIt last, Predicate pred)
+{
+    const size_t size = last - first;
+    if (size == 0)
+        return first;
+
+    const size_t no_of_chunks = std::min(size, 4 * pool.size());
+    const size_t chunk_size = (size + no_of_chunks - 1) / no_of_chunks;
+
+    std::vector<size_t> no_of_trues(no_of_chunks);
+    parallel_for(pool, size_t{0}, no_of_chunks, [&](size_t chunk) {
+        auto chunk_first = first + std::min(size, chunk * chunk_size);
+        auto chunk_last = first + std::min(size, (chunk + 1) * chunk_size);
+        no_of_trues[chunk] = std::partition(chunk_first, chunk_last, pred) - chunk_first;
+    }, size_t{1});
+
+    size_t partition_point = 0;
+    for (size_t count : no_of_trues)
+        partition_point += count;
+
+    struct Interval
+    {
+        size_t start;
+        size_t offset; // number of misplaced elements in the preceding intervals
+    };
+
+    std::vector<Interval> misplaced_falses, misplaced_trues;
+    size_t no_of_falses = 0, no_of_misplaced_trues = 0;
+
+    for (size_t chunk = 0; chunk < no_of_chunks; ++chunk)
+    {
+        const size_t chunk_first = std::min(size, chunk * chunk_size);
+        const size_t chunk_last = std::min(size, (chunk + 1) * chunk_size);
+        const size_t falses_first = chunk_first + no_of_trues[chunk];
+
+        size_t false_start = falses_first, false_end = std::min(chunk_last, partition_point);
+        if (false_start < false_end)
+        {
+            misplaced_falses.push_back(Interval{false_start, no_of_falses});
+            no_of_falses += false_end - false_start;
+        }
+
+        size_t true_start = std::max(chunk_first, partition_point), true_end = falses_first;
+        if (true_start < true_end)
+        {
+            misplaced_trues.push_back(Interval{true_start, no_of_misplaced_trues});
+            no_of_misplaced_trues += true_end - true_start;
+        }
+    }
+
+    assert(no_of_falses == no_of_misplaced_trues);
+
+    auto position = [](const std::vector<Interval>& intervals, size_t k) {
+        auto interval = std::upper_bound(intervals.begin(), intervals.end(), k, [](size_t value, const Interval& i) { return value < i.offset; }) - 1;
+        return interval->start + (k - interval->offset);
+    };
+
+    parallel_for(pool, size_t{0}, no_of_falses, [&](size_t k) {
+        std::iter_swap(first + position(misplaced_falses, k), first + position(misplaced_trues, k));
+    });
+
+    return first + partition_point;
+}
+
+#endif // WORK_STEALING_POOL_HPP